@@ -0,0 +1,162 @@
+/*********************************************************************************
+ * This file contains the function used to score a node to node mapping. The     *
+ * squared frobenius norm ||A - P A P^T|| is computed straight from the          *
+ * assignment array and the edges of the graph in O(|E|) instead of building the *
+ * permutation matrix and multiplying dense matrices, or from the bitset rows of *
+ * the graph (BitsetGraph) with one XOR popcount per row in O(|E| + n^2/64).     *
+ *********************************************************************************/
+
+#ifndef _AlignmentScore_h
+#define _AlignmentScore_h
+
+#include <vector>
+#include <algorithm>
+#include "Matrices/CSRGraph.h"
+#include "Matrices/BitsetGraph.h"
+#include "Matrices/MatrixPool.h"
+
+/*
+ * returns the entry (p,q) of the adjacency matrix of graph_A padded with the identity
+ * (A2 in the padded case where graph_A is smaller than graph_B)
+ * @pram: graph A
+ * @pram: row p
+ * @pram: column q
+ */
+inline int padded_entry(const CSRGraph& graph_A, int p, int q)
+{
+    if (p < graph_A.getNumberOfNodes() && q < graph_A.getNumberOfNodes())
+    {
+        return graph_A(p, q);
+    }
+    return (p == q) ? 1 : 0;
+}
+
+/*
+ * returns the squared frobenius norm of A - F where F(i,j) = A2(assignment[i], assignment[j]) for the
+ * nodes i,j of graph_A and A2 is graph_A padded with the identity to max(|A|,|B|) nodes. This is the
+ * norm of A - P A2 P^T restricted to the nodes of A, computed in O(|E| log(deg)).
+ * Since all entries are 0 or 1: ||A - F||^2 = nnz(A) + nnz(F) - 2 * |A and F|.
+ * Unassigned nodes (-1) are not mapped to anything.
+ * @pram: graph A
+ * @pram: array with the node of graph B assigned to every node of graph A
+ * @pram: number of nodes of graph B
+ */
+template <typename T>
+T alignment_frob_norm(const CSRGraph& graph_A, const int* assignment, int b_size)
+{
+    int a_size = graph_A.getNumberOfNodes();
+    int padded_size = std::max(a_size, b_size);
+
+    //how many nodes of A are mapped to every node of A2, 1 or 0 for a valid assignment
+    PooledArray<int> mapped_count(padded_size, 0);
+    for (int i = 0; i < a_size; i++)
+    {
+        if (assignment[i] >= 0)
+        {
+            mapped_count[assignment[i]]++;
+        }
+    }
+
+    //non-zero entries of F: edges of A between mapped nodes and the padded identity
+    long nnz_F = 0;
+    for (int p = 0; p < a_size; p++)
+    {
+        if (mapped_count[p] == 0)
+        {
+            continue;
+        }
+        for (const int* q = graph_A.neighborsBegin(p); q != graph_A.neighborsEnd(p); q++)
+        {
+            nnz_F += mapped_count[p] * mapped_count[*q];
+        }
+    }
+    for (int p = a_size; p < mapped_count.size(); p++)
+    {
+        nnz_F += mapped_count[p] * mapped_count[p];
+    }
+
+    //entries that are 1 in both A and F
+    long common = 0;
+    for (int i = 0; i < a_size; i++)
+    {
+        if (assignment[i] < 0)
+        {
+            continue;
+        }
+        for (const int* j = graph_A.neighborsBegin(i); j != graph_A.neighborsEnd(i); j++)
+        {
+            if (assignment[*j] >= 0)
+            {
+                common += padded_entry(graph_A, assignment[i], assignment[*j]);
+            }
+        }
+    }
+
+    return (T) (graph_A.getNumberOfEdges() + nnz_F - 2 * common);
+}
+
+/*
+ * same as alignment_frob_norm on the bitset rows of graph_A: every entry of A - F is 0 or 1 so the norm is the number of
+ * entries where the row i of A and the row i of F disagree, which are counted with XOR and popcount. The row of F is
+ * set from the neighbors of assignment[i] in O(deg), the norm costs O(|E| + n^2/64). An assignment that maps two nodes
+ * of A to the same node is scored by alignment_frob_norm.
+ * @pram: graph A
+ * @pram: bitset rows of graph A
+ * @pram: array with the node of graph B assigned to every node of graph A
+ * @pram: number of nodes of graph B
+ */
+template <typename T>
+T alignment_frob_norm(const CSRGraph& graph_A, const BitsetGraph& bits_A, const int* assignment, int b_size)
+{
+    int a_size = graph_A.getNumberOfNodes();
+    int padded_size = std::max(a_size, b_size);
+
+    //the node of A mapped to every node of A2
+    PooledArray<int> mapped_node(padded_size, -1);
+    for (int i = 0; i < a_size; i++)
+    {
+        if (assignment[i] >= 0)
+        {
+            if (mapped_node[assignment[i]] >= 0)
+            {
+                return alignment_frob_norm<T>(graph_A, assignment, b_size);
+            }
+            mapped_node[assignment[i]] = i;
+        }
+    }
+
+    //row i of F: the nodes mapped to the neighbors of assignment[i], or i itself on the padded identity
+    PooledArray<unsigned long long> row(bits_A.getNumberOfWords(), 0);
+    long mismatches = 0;
+    for (int i = 0; i < a_size; i++)
+    {
+        int p = assignment[i];
+        const int* begin = (p >= 0 && p < a_size) ? graph_A.neighborsBegin(p) : NULL;
+        const int* end = (p >= 0 && p < a_size) ? graph_A.neighborsEnd(p) : NULL;
+        for (const int* q = begin; q != end; q++)
+        {
+            if (mapped_node[*q] >= 0)
+            {
+                row[mapped_node[*q] / 64] |= 1ULL << (mapped_node[*q] % 64);
+            }
+        }
+        if (p >= a_size)
+        {
+            row[i / 64] |= 1ULL << (i % 64);
+        }
+
+        mismatches += bits_A.countMismatches(i, row.data());
+
+        for (const int* q = begin; q != end; q++)
+        {
+            if (mapped_node[*q] >= 0)
+            {
+                row[mapped_node[*q] / 64] = 0;
+            }
+        }
+        row[i / 64] = 0;
+    }
+    return (T) mismatches;
+}
+
+#endif
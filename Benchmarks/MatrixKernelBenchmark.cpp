@@ -0,0 +1,236 @@
+/*********************************************************************************
+ * Microbenchmark of the matrix kernels (Matrices/MatrixKernels.h). Every kernel *
+ * is timed at every level the CPU supports (scalar, avx2, avx512) and the speed *
+ * up over the textbook loop it replaces is printed, the popcount kernels are    *
+ * compared with counting the 1 entries of dense 0/1 rows. Build it with         *
+ * make benchmark and run ./MatrixKernelBenchmark [size]                         *
+ *********************************************************************************/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <chrono>
+#include "../Matrices/MatrixKernels.h"
+
+typedef float DataType;
+
+static const int DEFAULT_SIZE = 1024;
+static const double MIN_SECONDS = 0.2;
+
+/*
+ * returns the average time in milliseconds of a function, it is repeated until it ran for MIN_SECONDS
+ * @pram: the function
+ */
+template <typename F>
+double time_ms(F function)
+{
+    function();
+    int repetitions = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    double elapsed = 0;
+    do
+    {
+        function();
+        repetitions++;
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    } while (elapsed < MIN_SECONDS);
+    return 1000 * elapsed / repetitions;
+}
+
+/*
+ * prints one line of the table
+ * @pram: name of the kernel
+ * @pram: name of the version
+ * @pram: time of the version
+ * @pram: time of the textbook loop
+ */
+void print_row(const char* kernel, const char* version, double ms, double baseline_ms)
+{
+    printf("%-16s %-10s %12.3f ms %8.2fx\n", kernel, version, ms, baseline_ms / ms);
+}
+
+int main(int argc, char* argv[])
+{
+    int size = DEFAULT_SIZE;
+    if (argc > 1)
+    {
+        size = atoi(argv[1]);
+    }
+    if (size <= 0)
+    {
+        fprintf(stderr, "usage: %s [size]\n", argv[0]);
+        return 1;
+    }
+    int cpu_level = matrix_kernel_cpu_level();
+    printf("Matrix size: %d*%d, best kernels supported by the CPU: %s\n\n", size, size, matrix_kernel_name(cpu_level));
+    printf("%-16s %-10s %15s %9s\n", "kernel", "version", "time", "speedup");
+
+    size_t entries = (size_t) size * size;
+    std::vector<DataType> a(entries), b(entries), c(entries), sums(size);
+    for (size_t i = 0; i < entries; i++)
+    {
+        a[i] = (DataType) ((i * 7919) % 1000) / 1000;
+        b[i] = (DataType) ((i * 104729) % 1000) / 1000;
+    }
+    std::vector<const DataType*> a_rows(size), b_rows(size);
+    std::vector<DataType*> c_rows(size);
+    row_pointers(a.data(), size, size, a_rows.data());
+    row_pointers(b.data(), size, size, b_rows.data());
+    row_pointers(c.data(), size, size, c_rows.data());
+    volatile DataType sink = 0;
+
+    //0/1 adjacency matrices made of a and b, as dense rows and as bitset rows
+    size_t words = (size + 63) / 64;
+    std::vector<unsigned long long> a_bits(size * words, 0), b_bits(size * words, 0);
+    for (size_t i = 0; i < entries; i++)
+    {
+        a[i] = (a[i] < (DataType) 0.5) ? 1 : 0;
+        b[i] = (b[i] < (DataType) 0.5) ? 1 : 0;
+        a_bits[(i / size) * words + (i % size) / 64] |= (unsigned long long) (a[i] == 1) << ((i % size) % 64);
+        b_bits[(i / size) * words + (i % size) / 64] |= (unsigned long long) (b[i] == 1) << ((i % size) % 64);
+    }
+    volatile size_t count_sink = 0;
+
+    //textbook loops
+    double norm_loop = time_ms([&]()
+    {
+        DataType ret_val = 0;
+        for (size_t i = 0; i < entries; i++)
+        {
+            ret_val += a[i] * a[i];
+        }
+        sink = ret_val;
+    });
+    double row_sums_loop = time_ms([&]()
+    {
+        std::fill(sums.begin(), sums.end(), 0);
+        for (size_t i = 0; i < entries; i++)
+        {
+            sums[i / size] += a[i];
+        }
+    });
+    double axpy_loop = time_ms([&]()
+    {
+        for (size_t i = 0; i < entries; i++)
+        {
+            c[i] += (DataType) 0.5 * a[i];
+        }
+    });
+    double transpose_loop = time_ms([&]()
+    {
+        for (int i = 0; i < size; i++)
+        {
+            for (int j = 0; j < size; j++)
+            {
+                c[(size_t) j * size + i] = a[(size_t) i * size + j];
+            }
+        }
+    });
+    double gemm_loop = time_ms([&]()
+    {
+        for (int i = 0; i < size; i++)
+        {
+            for (int j = 0; j < size; j++)
+            {
+                DataType ret_val = 0;
+                for (int k = 0; k < size; k++)
+                {
+                    ret_val += a[(size_t) i * size + k] * b[(size_t) k * size + j];
+                }
+                c[(size_t) i * size + j] = ret_val;
+            }
+        }
+    });
+
+    double and_count_loop = time_ms([&]()
+    {
+        size_t ret_val = 0;
+        for (size_t i = 0; i < entries; i++)
+        {
+            ret_val += (a[i] == 1 && b[i] == 1) ? 1 : 0;
+        }
+        count_sink = ret_val;
+    });
+    double xor_count_loop = time_ms([&]()
+    {
+        size_t ret_val = 0;
+        for (size_t i = 0; i < entries; i++)
+        {
+            ret_val += (a[i] == 1) != (b[i] == 1) ? 1 : 0;
+        }
+        count_sink = ret_val;
+    });
+
+    print_row("frob norm", "loop", norm_loop, norm_loop);
+    for (int level = MATRIX_KERNEL_SCALAR; level <= cpu_level; level++)
+    {
+        set_matrix_kernel_level(level);
+        print_row("frob norm", matrix_kernel_name(level), time_ms([&]() { sink = kernel_sum_of_squares(a.data(), entries); }), norm_loop);
+    }
+
+    print_row("row sums", "loop", row_sums_loop, row_sums_loop);
+    for (int level = MATRIX_KERNEL_SCALAR; level <= cpu_level; level++)
+    {
+        set_matrix_kernel_level(level);
+        print_row("row sums", matrix_kernel_name(level), time_ms([&]()
+        {
+            std::fill(sums.begin(), sums.end(), 0);
+            kernel_row_sums(a_rows.data(), size, size, sums.data());
+        }), row_sums_loop);
+    }
+
+    print_row("axpy", "loop", axpy_loop, axpy_loop);
+    for (int level = MATRIX_KERNEL_SCALAR; level <= cpu_level; level++)
+    {
+        set_matrix_kernel_level(level);
+        print_row("axpy", matrix_kernel_name(level), time_ms([&]() { kernel_axpy((DataType) 0.5, a.data(), c.data(), entries); }), axpy_loop);
+    }
+
+    //the transpose does not depend on the level, it is only blocked
+    print_row("transpose", "loop", transpose_loop, transpose_loop);
+    print_row("transpose", "blocked", time_ms([&]() { kernel_transpose(a_rows.data(), c_rows.data(), size, size); }), transpose_loop);
+
+    //one call per row like BitsetGraph::commonNeighbors and countMismatches
+    print_row("and popcount", "loop", and_count_loop, and_count_loop);
+    for (int level = MATRIX_KERNEL_SCALAR; level <= cpu_level; level++)
+    {
+        set_matrix_kernel_level(level);
+        print_row("and popcount", matrix_kernel_name(level), time_ms([&]()
+        {
+            size_t ret_val = 0;
+            for (int i = 0; i < size; i++)
+            {
+                ret_val += kernel_and_popcount(&a_bits[i * words], &b_bits[i * words], words);
+            }
+            count_sink = ret_val;
+        }), and_count_loop);
+    }
+
+    print_row("xor popcount", "loop", xor_count_loop, xor_count_loop);
+    for (int level = MATRIX_KERNEL_SCALAR; level <= cpu_level; level++)
+    {
+        set_matrix_kernel_level(level);
+        print_row("xor popcount", matrix_kernel_name(level), time_ms([&]()
+        {
+            size_t ret_val = 0;
+            for (int i = 0; i < size; i++)
+            {
+                ret_val += kernel_xor_popcount(&a_bits[i * words], &b_bits[i * words], words);
+            }
+            count_sink = ret_val;
+        }), xor_count_loop);
+    }
+
+    print_row("gemm", "loop", gemm_loop, gemm_loop);
+    for (int level = MATRIX_KERNEL_SCALAR; level <= cpu_level; level++)
+    {
+        set_matrix_kernel_level(level);
+        print_row("gemm", matrix_kernel_name(level), time_ms([&]()
+        {
+            std::fill(c.begin(), c.end(), 0);
+            kernel_gemm(a_rows.data(), b_rows.data(), c_rows.data(), size, size, size);
+        }), gemm_loop);
+    }
+    return 0;
+}
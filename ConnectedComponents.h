@@ -0,0 +1,72 @@
+/*********************************************************************************
+ * This file contains the function used to find the connected components of an  *
+ * undirected graph in CSR form. The search is an iterative breadth first search *
+ * over the CSR arrays that writes one label per node into a flat array, so the  *
+ * depth of the graph does not matter and no per node objects are allocated.     *
+ *                                                                               *
+ *********************************************************************************/
+
+#ifndef _ConnectedComponents_h
+#define _ConnectedComponents_h
+
+#include "Matrices/CSRGraph.h"
+#include <vector>
+
+/*
+ * labels the connected components of an undirected graph and returns the number of components.
+ * The components are numbered in the order of their smallest node, isolated nodes are components of their own.
+ * order gets the nodes in the order they are found: the nodes of a component are contiguous, components
+ * follow each other in label order and the first node of each component is its smallest node.
+ * @pram: the graph (symmetric)
+ * @pram: the labels that get filled, one per node
+ * @pram: the search order that gets filled, one entry per node
+ */
+inline int connected_components(const CSRGraph& graph, std::vector<int>& labels, std::vector<int>& order)
+{
+    int nodes = graph.getNumberOfNodes();
+    labels.assign(nodes, -1);
+    order.resize(nodes);
+    int number_of_components = 0;
+    int head = 0;
+    int tail = 0;
+
+    for (int root = 0; root < nodes; root++)
+    {
+        if (labels[root] != -1)
+        {
+            continue;
+        }
+
+        //the queue is the order array, every node enters it once
+        order[tail++] = root;
+        labels[root] = number_of_components;
+        while (head < tail)
+        {
+            int i = order[head++];
+            for (const int* j = graph.neighborsBegin(i); j != graph.neighborsEnd(i); j++)
+            {
+                if (labels[*j] == -1)
+                {
+                    labels[*j] = number_of_components;
+                    order[tail++] = *j;
+                }
+            }
+        }
+        number_of_components++;
+    }
+    return number_of_components;
+}
+
+/*
+ * labels the connected components of an undirected graph and returns the number of components,
+ * see above for the numbering.
+ * @pram: the graph (symmetric)
+ * @pram: the labels that get filled, one per node
+ */
+inline int connected_components(const CSRGraph& graph, std::vector<int>& labels)
+{
+    std::vector<int> order;
+    return connected_components(graph, labels, order);
+}
+
+#endif
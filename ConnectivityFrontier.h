@@ -0,0 +1,600 @@
+/*********************************************************************************
+ * This file contains the ConnectivityFrontier class used by the greedy and the  *
+ * connectivity matchers (con-enf-1 to con-enf-4). The frontier holds the nodal  *
+ * pairs the next match is taken from (the pairs between the neighbors of matched*
+ * pairs or all of them) sorted by score, or in a heap once pairs are added to   *
+ * it, so a step only looks at the pairs chained to the best one instead of the  *
+ * whole scores matrix, and the neighbors of a new pair are added in O(d1 d2 log)*
+ * without touching the other pairs. Assigned rows and columns are skipped       *
+ * lazily, the columns a row may still be matched to are kept in a bitset and the*
+ * number of assigned neighbors of every node is updated in O(deg) per           *
+ * assignment. The random choices are the ones return_max, find_values and the   *
+ * connectivity counts of the original algorithms made.                          *
+ *********************************************************************************/
+
+#ifndef _ConnectivityFrontier_h
+#define _ConnectivityFrontier_h
+
+#include <vector>
+#include <algorithm>
+#include <float.h>
+#include "Matrices/DenseMatrix1D.h"
+#include "Matrices/CSRGraph.h"
+#include "GreedyAlgorithmsHelper.h"
+#include "Random.h"
+
+/*
+ * ConnectivityFrontier class definition and method declarations.
+ */
+template <typename DT>
+class ConnectivityFrontier
+{
+private:
+    /*
+     * a nodal pair of the frontier
+     */
+    struct Entry
+    {
+        DT score;
+        int row;
+        int col;
+    };
+
+    /*
+     * frontier order, the best pair is the largest score and equal scores come out in row major order
+     */
+    struct ByScore
+    {
+        bool operator()(const Entry& a, const Entry& b) const
+        {
+            return (a.score < b.score) || (a.score == b.score && (a.row > b.row || (a.row == b.row && a.col > b.col)));
+        }
+    };
+
+    /*
+     * orders entries in row major order
+     */
+    struct ByIndex
+    {
+        bool operator()(const Entry& a, const Entry& b) const
+        {
+            return a.row < b.row || (a.row == b.row && a.col < b.col);
+        }
+    };
+
+    bool _isValid(const Entry&) const;
+    bool _popValid(Entry* entry);
+    void _push(const Entry& entry);
+    bool _addPair(int row, int col);
+    void _scanMax(DT* total_score, int* max_row, int* max_col, Random& rng);
+
+protected:
+    DenseMatrix1D<DT>& _matches;
+    CSRGraph& _graph1;
+    CSRGraph& _graph2;
+    int _rows;
+    int _cols;
+    std::vector<Entry> _entries;
+    bool _heap;
+    std::vector<Entry> _ties;
+    std::vector<Entry> _scan;
+    std::vector<coordinate_pair> _values;
+    std::vector<int> _candidates;
+    std::vector<char> _added;
+    int _words;
+    std::vector<char> _row_restricted;
+    std::vector<unsigned long long> _allowed;
+    std::vector<unsigned long long> _neighbor_columns;
+    std::vector<char> _row_used;
+    std::vector<char> _col_used;
+    std::vector<int> _connectivity1;
+    std::vector<int> _connectivity2;
+
+public:
+    /**************
+     *Constructors*
+     **************/
+    ConnectivityFrontier(DenseMatrix1D<DT>& matches, CSRGraph& graph1, CSRGraph& graph2);
+
+    /**********
+    *OPERATIONS*
+    **********/
+    void clear();
+    void setNeighbors(int row, int col);
+    void addNeighbors(int row, int col);
+    void setAllPairs();
+    void invalidate(int row, int col);
+    void restrictNeighbors(int row, int col);
+    void assign(int row, int col, int* assignment);
+    bool returnMax(DT* total_score, int* max_row, int* max_col, Random& rng);
+    int findValues(DT value);
+    int mostConnectedRow(Random& rng);
+    int mostConnectedColumn(int row, Random& rng);
+
+    /***********
+     *ACCESSORS*
+     ***********/
+    const std::vector<coordinate_pair>& getValues() const;
+    bool allInf();
+};
+
+//==========================================================CONSTRUCTORS============================================================
+/*
+ * ConnectivityFrontier constructor, the frontier is empty.
+ * @pram DenseMatrix1D<DT>: matrix indicating the scores of nodal pairings, it is not modified
+ * @pram CSRGraph: graph1
+ * @pram CSRGraph: graph2
+ */
+template <typename DT>
+inline ConnectivityFrontier<DT>::ConnectivityFrontier(DenseMatrix1D<DT>& matches, CSRGraph& graph1, CSRGraph& graph2)
+    : _matches(matches), _graph1(graph1), _graph2(graph2)
+{
+    this->_rows = matches.getNumberOfRows();
+    this->_cols = matches.getNumberOfColumns();
+    this->_words = (this->_cols + 63) / 64;
+    this->_heap = false;
+    this->_row_used.assign(this->_rows, 0);
+    this->_col_used.assign(this->_cols, 0);
+    this->_row_restricted.assign(this->_rows, 0);
+}
+
+//===========================================================OPERATIONS================================================================
+/*
+ * Empties the frontier, the assigned rows and columns are kept.
+ */
+template <typename DT>
+inline void ConnectivityFrontier<DT>::clear()
+{
+    for (size_t i = 0; i < this->_entries.size() && !this->_added.empty(); i++)
+    {
+        this->_added[(size_t) this->_entries[i].row * this->_cols + this->_entries[i].col] = 0;
+    }
+    this->_entries.clear();
+    this->_heap = false;
+}
+
+/*
+ * Replaces the frontier by the valid pairs between the neighbors of row in graph1 and the neighbors of col in graph2,
+ * O(d1 d2 log(d1 d2)). The pairs are sorted with the best one last.
+ * @pram: node of graph1
+ * @pram: node of graph2
+ */
+template <typename DT>
+inline void ConnectivityFrontier<DT>::setNeighbors(int row, int col)
+{
+    this->clear();
+    for (const int* i = this->_graph1.neighborsBegin(row); i != this->_graph1.neighborsEnd(row); i++)
+    {
+        for (const int* j = this->_graph2.neighborsBegin(col); j != this->_graph2.neighborsEnd(col); j++)
+        {
+            this->_addPair(*i, *j);
+        }
+    }
+    std::sort(this->_entries.begin(), this->_entries.end(), ByScore());
+}
+
+/*
+ * Adds the valid pairs between the neighbors of row in graph1 and the neighbors of col in graph2 that are not in the
+ * frontier yet, O(d1 d2 log(size of the frontier)). The first call allocates one flag per pair of the scores matrix and
+ * turns the sorted pairs into a heap.
+ * @pram: node of graph1
+ * @pram: node of graph2
+ */
+template <typename DT>
+inline void ConnectivityFrontier<DT>::addNeighbors(int row, int col)
+{
+    if (this->_added.empty())
+    {
+        this->_added.assign((size_t) this->_rows * this->_cols, 0);
+        for (size_t i = 0; i < this->_entries.size(); i++)
+        {
+            this->_added[(size_t) this->_entries[i].row * this->_cols + this->_entries[i].col] = 1;
+        }
+    }
+    if (!this->_heap)
+    {
+        std::make_heap(this->_entries.begin(), this->_entries.end(), ByScore());
+        this->_heap = true;
+    }
+    for (const int* i = this->_graph1.neighborsBegin(row); i != this->_graph1.neighborsEnd(row); i++)
+    {
+        for (const int* j = this->_graph2.neighborsBegin(col); j != this->_graph2.neighborsEnd(col); j++)
+        {
+            if (!this->_added[*i * this->_cols + *j] && this->_addPair(*i, *j))
+            {
+                this->_added[*i * this->_cols + *j] = 1;
+                std::push_heap(this->_entries.begin(), this->_entries.end(), ByScore());
+            }
+        }
+    }
+}
+
+/*
+ * Replaces the frontier by all the valid pairs of the scores matrix sorted with the best one last, O(nm log(nm)).
+ */
+template <typename DT>
+inline void ConnectivityFrontier<DT>::setAllPairs()
+{
+    this->clear();
+    this->_entries.reserve((size_t) this->_rows * this->_cols);
+    for (int i = 0; i < this->_rows; i++)
+    {
+        for (int j = 0; j < this->_cols; j++)
+        {
+            this->_addPair(i, j);
+        }
+    }
+    std::sort(this->_entries.begin(), this->_entries.end(), ByScore());
+}
+
+/*
+ * Marks a row and a column as assigned, the pairs using them are skipped from now on.
+ * @pram: row we wish to invalidate
+ * @pram: column we wish to invalidate
+ */
+template <typename DT>
+inline void ConnectivityFrontier<DT>::invalidate(int row, int col)
+{
+    this->_row_used[row] = 1;
+    this->_col_used[col] = 1;
+}
+
+/*
+ * Enforces the connectivity of con-enf-1: from now on the neighbors of row in graph1 may only be matched to neighbors
+ * of col in graph2. Every free neighbor of row keeps a bitset of the columns it may still be matched to, which is
+ * intersected with the neighbors of col, O(d1 m / 64).
+ * @pram: row that was assigned
+ * @pram: column row was assigned to
+ */
+template <typename DT>
+inline void ConnectivityFrontier<DT>::restrictNeighbors(int row, int col)
+{
+    int words = this->_words;
+    if (this->_allowed.empty())
+    {
+        this->_allowed.resize((size_t) this->_rows * words);
+    }
+    this->_neighbor_columns.assign(words, 0);
+    for (const int* j = this->_graph2.neighborsBegin(col); j != this->_graph2.neighborsEnd(col); j++)
+    {
+        this->_neighbor_columns[*j / 64] |= 1ULL << (*j % 64);
+    }
+
+    for (const int* i = this->_graph1.neighborsBegin(row); i != this->_graph1.neighborsEnd(row); i++)
+    {
+        if (this->_row_used[*i])
+        {
+            continue;
+        }
+        unsigned long long* allowed = &this->_allowed[(size_t) *i * words];
+        if (!this->_row_restricted[*i])
+        {
+            std::copy(this->_neighbor_columns.begin(), this->_neighbor_columns.end(), allowed);
+            this->_row_restricted[*i] = 1;
+            continue;
+        }
+        for (int w = 0; w < words; w++)
+        {
+            allowed[w] &= this->_neighbor_columns[w];
+        }
+    }
+}
+
+/*
+ * Matches row to col, the pairs using them are skipped from now on. The first time a row is assigned the connectivity
+ * of its neighbors in graph1 goes up by one, and so does the one of the neighbors in graph2 of the node with the same
+ * index (the original algorithm read the neighbors of graph2 from the rows of the assignment of graph1).
+ * @pram: row to assign
+ * @pram: column to assign
+ * @pram: array of assignments
+ */
+template <typename DT>
+inline void ConnectivityFrontier<DT>::assign(int row, int col, int* assignment)
+{
+    if (this->_connectivity1.empty())
+    {
+        this->_connectivity1.assign(this->_rows, 0);
+        this->_connectivity2.assign(this->_cols, 0);
+    }
+    if (assignment[row] == -1)
+    {
+        for (const int* i = this->_graph1.neighborsBegin(row); i != this->_graph1.neighborsEnd(row); i++)
+        {
+            this->_connectivity1[*i]++;
+        }
+        if (row < this->_cols)
+        {
+            for (const int* j = this->_graph2.neighborsBegin(row); j != this->_graph2.neighborsEnd(row); j++)
+            {
+                this->_connectivity2[*j]++;
+            }
+        }
+    }
+    assignment[row] = col;
+    this->invalidate(row, col);
+}
+
+/*
+ * Same as return_max on the frontier: adds the largest score to total_score and sets max_row and max_col to a random
+ * occurrence of it. Only the pairs chained to the best one by scores within the tie tolerance are looked at, the
+ * scores below the chain can not change the running maximum of return_max. Returns false if the frontier has no valid
+ * pair (max_row and max_col are then 0 like return_max leaves them).
+ * @pram: pointer to variable the largest score is added to
+ * @pram: pointer to row variable which we set to the row of the largest value
+ * @pram: pointer to column variable which we set to the column of the largest value
+ * @pram: random number generator used to break ties
+ */
+template <typename DT>
+inline bool ConnectivityFrontier<DT>::returnMax(DT* total_score, int* max_row, int* max_col, Random& rng)
+{
+    //the pairs come out of the frontier from the best one down, the chain stops at the first score clearly below the last
+    //one, every pair of the chain beats it and it can not beat any of them
+    this->_ties.clear();
+    Entry entry;
+    bool next = false;
+    while (this->_popValid(&entry))
+    {
+        if (!this->_ties.empty() && compareFloats(this->_ties.back().score, entry.score) == 1)
+        {
+            next = true;
+            break;
+        }
+        this->_ties.push_back(entry);
+    }
+    if (next)
+    {
+        this->_push(entry);
+    }
+    for (size_t i = this->_ties.size(); i > 0; i--)
+    {
+        this->_push(this->_ties[i - 1]);
+    }
+    std::sort(this->_ties.begin(), this->_ties.end(), ByIndex());
+    this->_scanMax(total_score, max_row, max_col, rng);
+    return !this->_ties.empty();
+}
+
+/*
+ * Same as find_values on the frontier, with the pairs kept: collects the valid pairs whose score is at least
+ * value (see compareFloats) in row major order and returns their number.
+ * @pram: the smallest score
+ */
+template <typename DT>
+inline int ConnectivityFrontier<DT>::findValues(DT value)
+{
+    this->_scan.clear();
+    Entry entry;
+    while (this->_popValid(&entry))
+    {
+        if (compareFloats(entry.score, value) == -1)
+        {
+            this->_push(entry);
+            break;
+        }
+        this->_scan.push_back(entry);
+    }
+    for (size_t i = this->_scan.size(); i > 0; i--)
+    {
+        this->_push(this->_scan[i - 1]);
+    }
+    std::sort(this->_scan.begin(), this->_scan.end(), ByIndex());
+
+    this->_values.resize(this->_scan.size());
+    for (size_t i = 0; i < this->_scan.size(); i++)
+    {
+        this->_values[i].row = this->_scan[i].row;
+        this->_values[i].col = this->_scan[i].col;
+    }
+    return this->_values.size();
+}
+
+/*
+ * Returns a random row of the last findValues with the most assigned neighbors in graph1. If none of them has an
+ * assigned neighbor any row of the scores matrix can be returned, like vector_max did on the counts.
+ * @pram: random number generator used to break ties
+ */
+template <typename DT>
+inline int ConnectivityFrontier<DT>::mostConnectedRow(Random& rng)
+{
+    int max_connectivity = 0;
+    for (size_t i = 0; i < this->_values.size(); i++)
+    {
+        max_connectivity = std::max(max_connectivity, this->_connectivity1[this->_values[i].row]);
+    }
+    if (max_connectivity == 0)
+    {
+        return rng.nextInt(this->_rows);
+    }
+
+    //the values are in row major order, so the rows come out sorted
+    this->_candidates.clear();
+    for (size_t i = 0; i < this->_values.size(); i++)
+    {
+        int row = this->_values[i].row;
+        if (this->_connectivity1[row] == max_connectivity && (this->_candidates.empty() || this->_candidates.back() != row))
+        {
+            this->_candidates.push_back(row);
+        }
+    }
+    return this->_candidates[rng.nextInt(this->_candidates.size())];
+}
+
+/*
+ * Returns a random column paired with row in the last findValues with the most assigned neighbors in graph2. If none
+ * of them has an assigned neighbor any column of the scores matrix can be returned, like vector_max did on the counts.
+ * @pram: the row chosen by mostConnectedRow
+ * @pram: random number generator used to break ties
+ */
+template <typename DT>
+inline int ConnectivityFrontier<DT>::mostConnectedColumn(int row, Random& rng)
+{
+    int max_connectivity = 0;
+    this->_candidates.clear();
+    for (size_t i = 0; i < this->_values.size(); i++)
+    {
+        if (this->_values[i].row != row)
+        {
+            continue;
+        }
+        int col = this->_values[i].col;
+        if (this->_connectivity2[col] > max_connectivity)
+        {
+            max_connectivity = this->_connectivity2[col];
+            this->_candidates.clear();
+        }
+        if (this->_connectivity2[col] == max_connectivity)
+        {
+            this->_candidates.push_back(col);
+        }
+    }
+    if (max_connectivity == 0)
+    {
+        return rng.nextInt(this->_cols);
+    }
+    return this->_candidates[rng.nextInt(this->_candidates.size())];
+}
+
+//===========================================================ACCESSORS===============================================================
+/*
+ * Returns the pairs found by the last findValues in row major order.
+ */
+template <typename DT>
+inline const std::vector<coordinate_pair>& ConnectivityFrontier<DT>::getValues() const
+{
+    return this->_values;
+}
+
+/*
+ * Returns true if no valid pair of the frontier has a positive score.
+ */
+template <typename DT>
+inline bool ConnectivityFrontier<DT>::allInf()
+{
+    Entry entry;
+    if (!this->_popValid(&entry))
+    {
+        return true;
+    }
+    this->_push(entry);
+    return !(entry.score > 0);
+}
+
+//===========================================================PRIVATE=================================================================
+/*
+ * Returns true if neither the row nor the column of an entry is assigned and the row may be matched to the column.
+ * @pram: Entry
+ */
+template <typename DT>
+inline bool ConnectivityFrontier<DT>::_isValid(const Entry& entry) const
+{
+    if (this->_row_used[entry.row] || this->_col_used[entry.col])
+    {
+        return false;
+    }
+    return !this->_row_restricted[entry.row] || ((this->_allowed[(size_t) entry.row * this->_words + entry.col / 64] >> (entry.col % 64)) & 1);
+}
+
+/*
+ * Takes the best valid pair out of the frontier, the invalid pairs above it are dropped. Returns false if there is
+ * none.
+ * @pram: pointer to the Entry that gets the pair
+ */
+template <typename DT>
+inline bool ConnectivityFrontier<DT>::_popValid(Entry* entry)
+{
+    while (!this->_entries.empty())
+    {
+        if (this->_heap)
+        {
+            std::pop_heap(this->_entries.begin(), this->_entries.end(), ByScore());
+        }
+        *entry = this->_entries.back();
+        this->_entries.pop_back();
+        if (this->_isValid(*entry))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Puts a pair back in the frontier. While it is sorted only the pairs taken out by _popValid can be put back, in the
+ * reverse order.
+ * @pram: Entry
+ */
+template <typename DT>
+inline void ConnectivityFrontier<DT>::_push(const Entry& entry)
+{
+    this->_entries.push_back(entry);
+    if (this->_heap)
+    {
+        std::push_heap(this->_entries.begin(), this->_entries.end(), ByScore());
+    }
+}
+
+/*
+ * Appends a pair to the frontier (without restoring its order) if it is valid and has a score, returns true if it was
+ * appended.
+ * @pram: row
+ * @pram: column
+ */
+template <typename DT>
+inline bool ConnectivityFrontier<DT>::_addPair(int row, int col)
+{
+    Entry entry;
+    entry.score = this->_matches(row, col);
+    entry.row = row;
+    entry.col = col;
+    if (!this->_isValid(entry) || !(entry.score > (DT) -DBL_MAX))
+    {
+        return false;
+    }
+    this->_entries.push_back(entry);
+    return true;
+}
+
+/*
+ * return_max on the chain of pairs collected by returnMax in row major order.
+ * @pram: pointer to variable the largest score is added to
+ * @pram: pointer to row variable which we set to the row of the largest value
+ * @pram: pointer to column variable which we set to the column of the largest value
+ * @pram: random number generator used to break ties
+ */
+template <typename DT>
+inline void ConnectivityFrontier<DT>::_scanMax(DT* total_score, int* max_row, int* max_col, Random& rng)
+{
+    DT max_so_far = -DBL_MAX;
+    int max_so_far_count = 1;
+    *max_row = 0;
+    *max_col = 0;
+    for (size_t i = 0; i < this->_ties.size(); i++)
+    {
+        int comparison = compareFloats(this->_ties[i].score, max_so_far);
+        if (comparison == 0)
+        {
+            max_so_far_count++;
+        }
+        else if (comparison == 1)
+        {
+            max_so_far = this->_ties[i].score;
+            max_so_far_count = 1;
+        }
+    }
+
+    int counter = 0;
+    int random_number = rng.nextInt(max_so_far_count) + 1;
+    for (size_t i = 0; i < this->_ties.size(); i++)
+    {
+        if (compareFloats(this->_ties[i].score, max_so_far) == 0 && ++counter == random_number)
+        {
+            *max_row = this->_ties[i].row;
+            *max_col = this->_ties[i].col;
+            break;
+        }
+    }
+    *total_score += max_so_far;
+}
+
+//===================================================================================================================================
+#endif
@@ -0,0 +1,62 @@
+/*********************************************************************************
+ * This file contains the function used to read a directory of graph files. The  *
+ * files are read in parallel with the PairScheduler (one task per file) and the *
+ * graphs are returned in file order. Files that can not be read are reported    *
+ * in file order as well so the output does not depend on the threads.           *
+ *********************************************************************************/
+
+#ifndef _GraphLoader_h
+#define _GraphLoader_h
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include "PairScheduler.h"
+
+/*
+ * reads the files dir_path + i + file_extension for i = 1..number_of_files and returns the graphs that were read
+ * @pram: directory of the files
+ * @pram: extension of the files
+ * @pram: number of files
+ * @pram: number of threads (0 uses all the cores)
+ * @pram: pointer to the vector that gets the error message of every file that could not be read
+ */
+template <typename Matrix>
+std::vector<Matrix*> load_graphs(const std::string& dir_path, const std::string& file_extension, int number_of_files,
+                                 int num_threads, std::vector<std::string>* errors)
+{
+    std::vector<Matrix*> loaded(number_of_files, (Matrix*) NULL);
+    std::vector<std::string> file_errors(number_of_files);
+
+    PairScheduler scheduler(number_of_files, num_threads);
+    auto load_file = [&](int task, int worker)
+    {
+        std::ostringstream itos_converter;
+        itos_converter << dir_path << task + 1 << file_extension;
+        try
+        {
+            loaded[task] = new Matrix(itos_converter.str());
+        }
+        catch (std::exception& e)
+        {
+            file_errors[task] = e.what();
+        }
+    };
+    scheduler.run(load_file);
+
+    std::vector<Matrix*> graphs;
+    for (int i = 0; i < number_of_files; i++)
+    {
+        if (loaded[i] != NULL)
+        {
+            graphs.push_back(loaded[i]);
+        }
+        else
+        {
+            errors->push_back(file_errors[i]);
+        }
+    }
+    return graphs;
+}
+
+#endif
@@ -16,15 +16,15 @@
 #include <vector>
 #include <cmath>
 #include "Matrices/DenseMatrix1D.h"
+#include "Matrices/CSRGraph.h"
+#include "Matrices/MatrixPool.h"
+#include "Random.h"
 #include <limits>
 
 
 
 
-std::vector<int>* intersect(int*, int, struct coordinate_pair**,int);
-void match_rest(int*, DenseMatrix1D<float>&, DenseMatrix1D<float>&);
-int* get_valid_entries(DenseMatrix1D<float>, int*,int,int*);
-std::vector<int>* choose_cols(struct coordinate_pair**,int,int);
+void match_rest(int*, CSRGraph&, CSRGraph&);
 
 
 /*
@@ -39,17 +39,25 @@ struct coordinate_pair{
 
 
 
+/*
+ * returns the tolerance under which two scores are a tie for compareFloats, the float epsilon unless it was changed
+ * (e.g. to follow the accuracy of the eigensolve), set it before the matching algorithms run on other threads
+ */
+inline float& score_tie_tolerance()
+{
+    static float tolerance = std::numeric_limits<float>::epsilon();
+    return tolerance;
+}
+
 /*
  * compares two floats and returns whether
  * an integer to indicate which is bigger
- * 0 if a=b, 1 if a>b, -1 a<b
+ * 0 if a=b (closer than score_tie_tolerance), 1 if a>b, -1 a<b
  * @pram: float to be compared
  * @pram: float to be compared
  */
-int compareFloats(float a, float b){
-    float smallest_float= std::numeric_limits<float>::epsilon();
-    
-    if(abs(a-b)<smallest_float){
+inline int compareFloats(float a, float b){
+    if(std::fabs(a-b)<score_tie_tolerance()){
         return 0;
     }
     else if(a-b>0)
@@ -59,28 +67,6 @@ int compareFloats(float a, float b){
     
 }
 
-/*
- * returns a std::vector of the columns col
- * such that (row,col) is a pair in rc
- * @pram: array of structs of coordinate pairs
- * @pram: size of the array of structs
- * @pram: the row we wish to match
- */
-std::vector<int>* choose_cols(struct coordinate_pair** rc,int rc_size,int row){
-    std::vector<int> *ret_vec= new std::vector<int>(0);
-    
-    for(int i=0;i<rc_size;i++){
-        struct coordinate_pair *pair=rc[i];
-        
-        if(pair->row==row){
-            ret_vec->push_back(pair->col);
-        }
-    }
-    
-    return ret_vec;
-}
-
-
 /*
  * returns a DenseMatrix1D Object which is a reshaped eigenvector
  * @pram: a pointer to an array of doubles which represents the eigenvector
@@ -114,254 +100,6 @@ DenseMatrix1D<DT> reshape(DT* eigenvector,const int rows,const int cols, std::ve
 }
 
 
-/*
- * helper function for greedy_connectivity_1 sets certain rows and columns to -DBL_MAX
- * @pram: pointer to the row which should be invalidated and turned to -inf
- * @pram: pointer to the column which should be invalidated and turned to -inf
- * @pram: adjacency matrix for graph1
- * @pram: adjacency matrix for graph2
- * @pram: matrix indicating scores for nodal pairs
- */
-template<typename DT>
-void neighbor_enforcement(int* row_index,int* col_index, DenseMatrix1D<float>& graph1,DenseMatrix1D<float>& graph2, DenseMatrix1D<DT>& matches){
-    
-    
-    for(int i=0;i<graph1.getNumberOfColumns();i++){
-        if(graph1(*row_index, i)==1){
-            for(int j=0;j<graph2.getNumberOfRows();j++){
-                //if node i neighbors node row_index in graph1
-                // and node j does not neighbor col_index invalidate (i,j) matching
-                if(graph2(j, *col_index)==0){
-                    matches(i,j)=-DBL_MAX;
-                }
-            }
-        }
-    }
-    
-    for(int i=0;i<graph2.getNumberOfColumns();i++){
-        if(graph2(*col_index, i)==1){
-            for(int j=0;j<graph1.getNumberOfRows();j++){
-                //if node j neighbors node col_index in graph2
-                // and node i does not neighbor row_index invalidate (i,j) matching
-                if(graph1(j,*row_index)==0){
-                    matches(j, i)==-DBL_MAX;
-                }
-            }
-        }
-    }
-}
-
-/*
- * returns a std::vector of nodes from graph1 such that the
- * node r exists as a pair (r,c) in row_cols and
- * c is exists in array cols
- * @pram: array of nodes in graph2 being considered for the matching
- * @pram: size of array that contains nodes from graph2
- * @pram: array of coordinate_pair structs being considered for matching
- * @pram: size of the array row_cols
- */
-std::vector<int>* intersect(int* cols, int cols_size, struct coordinate_pair** row_cols,int row_cols_size){
-    std::vector<int>* ret_value=new std::vector<int>();
-    int counter=0;
-    
-    for(int j=0;j<row_cols_size;j++){
-        int curr_row=row_cols[j]->row;
-        for(int i=0;i<cols_size;i++){
-            if(curr_row==cols[i]){
-                ret_value->insert(ret_value->begin()+counter,curr_row);
-                counter++;
-            }
-        }
-    }
-    
-    return ret_value;
-}
-
-/*
- * returns array of nodes from graph2 that can be made availabe for matching
- * @pram: DenseMatrix1D representing graph1
- * @pram: array of assignments
- * @pram: size of assignments array
- * @pram: size of returned array
- */
-int* get_valid_entries(DenseMatrix1D<float> graph1, int* ass,int size,int* ret_size){
-    
-    std::vector<int> assigned;
-    DenseMatrix1D<float>* graph_copy=new DenseMatrix1D<float>(graph1);
-    
-    for(int i=0;i<size;i++){
-        if(ass[i]!=-1){
-            assigned.push_back(i);
-        }
-    }
-    int invalidate=1;
-    *ret_size=0;
-    
-    //invalidate certain nodes from consideration for matching
-    for(int i=0;i<graph_copy->getNumberOfRows();i++) {
-        
-        for(int k=0;k<assigned.size();k++){
-            if(assigned[k]==i){
-                invalidate=0;
-                break;
-            }
-        }
-        if(invalidate==1){
-            for(int j=0;j<graph_copy->getNumberOfColumns();j++){
-                (*graph_copy)(i,j)=-DBL_MAX;
-            }
-        }
-        else{
-            for(int j=0;j<graph_copy->getNumberOfColumns();j++){
-                if((*graph_copy)(i,j)==1)
-                    *ret_size=*ret_size+1;
-            }
-            invalidate=1;
-        }
-    }
-    
-    int* ret_arr=new int[*ret_size];
-    int ret_arr_counter=0;
-    int counter=0;
-    
-    
-    for(int j=0;j<graph1.getNumberOfRows();j++){
-        for(int i=0;i<graph1.getNumberOfColumns();i++){
-            if((*graph_copy)(j,i)==1){
-                ret_arr[ret_arr_counter]=i;
-                ret_arr_counter++;
-            }
-            counter++;
-        }
-    }
-    delete graph_copy;
-    
-    return ret_arr;
-    
-}
-
-
-/*
- * returns an array of coordinate_pair structs (r,c)
- * such that r,c in scores_matrix has a high score
- * @pram: DenseMatrix1D that represents the nodal pairings scores
- * @pram: array of values that are high enough and in local_matches
- * @pram: size of array val
- * @pram: size of the array returned
- */
-template <typename DT>
-struct coordinate_pair** find_all_values(DenseMatrix1D<DT>& local_matches,DT* val,int val_size,int* row_cols_size){
-    
-    int rows=local_matches.getNumberOfRows();
-    int cols=local_matches.getNumberOfColumns();
-    
-    int size=0;
-    DenseMatrix1D<DT>* local_matches_copy=new DenseMatrix1D<DT>(local_matches);
-    
-    //count the number of values that we wish to consider
-    for(int i=0;i<local_matches_copy->getNumberOfRows();i++){
-        for(int j=0;j<local_matches_copy->getNumberOfColumns();j++){
-            for(int k=0;k<val_size;k++){
-                if(compareFloats(val[k],(*local_matches_copy)(i,j))==0){
-                    (*local_matches_copy)(i,j)=-DBL_MAX;
-                    size++;
-                }
-            }
-        }
-    }
-    
-    delete local_matches_copy;
-    
-    local_matches_copy=new DenseMatrix1D<DT>(local_matches);
-    
-    *row_cols_size=val_size;
-    struct coordinate_pair **ret_value= new struct coordinate_pair*[val_size];
-    struct coordinate_pair *pair;
-    int counter=0,val_counter=0,ret_val_counter=0;
-    
-    //add all the nodal pairings that are greater than a certain value to the final array of pairings
-    for(int i=0;i<local_matches.getNumberOfRows();i++){
-        for(int j=0;j<local_matches.getNumberOfColumns();j++) {
-            if(val_counter<val_size&&val[val_counter]==counter) {
-                pair=(struct coordinate_pair*)malloc(sizeof(struct coordinate_pair));
-                pair->row=i;
-                pair->col=j;
-                ret_value[ret_val_counter]=pair;
-                ret_val_counter++;
-                val_counter++;
-            }
-            counter++;
-        }
-    }
-    delete local_matches_copy;
-    return ret_value;
-}
-
-
-
-
-/*
- * checks whether all entries in a matrix are negative
- * @pram: an instance of a DenseMatrix1D that has all negative numbers
- */
-
-template <typename DT>
-int all_inf(DenseMatrix1D<DT> &mat){
-    for(int i=0;i<mat.getNumberOfRows();i++){
-        for(int j=0;j<mat.getNumberOfColumns();j++){
-            if(mat(i,j)>0){
-                return 0;
-            }
-        }
-    }
-    return 1;
-}
-
-
-/*
- * sets all entries in a matrix to be -inf
- * @pram: matrix that gets set to -inf
- */
-template <typename DT>
-void set_to_min(DenseMatrix1D<DT>& matrix){
-    
-    for(int i=0;i<matrix.getNumberOfRows();i++){
-        for(int j=0;j<matrix.getNumberOfColumns();j++){
-            matrix(i,j)=-DBL_MAX;
-        }
-    }
-    
-}
-
-/*
- * sets certain values of matrix1 to be certain values of matrix2
- * @pram: DenseMatrix1D which gets changed
- * @pram: DenseMatrix1D whose values are used to change matrix1
- * @pram: std::vector representing the rows that need to be changed
- * @pram: std::vector representing the columns that need to be changed
- */
-template<typename DT>
-void set_matrix_values(DenseMatrix1D<DT>& matrix1,DenseMatrix1D<DT>& matrix2,  std::vector<int>& rows, std::vector<int>& cols){
-    int r;
-    int c;
-    
-    
-    for(int i=0;i<matrix1.getNumberOfRows();i++){
-        for(int j=0;j<matrix1.getNumberOfColumns();j++){
-            matrix1(i,j)=-DBL_MAX;
-        }
-    }
-    
-    
-    for(int i=0;i<rows.size();i++){
-        r=rows[i];
-        for(int j=0;j<cols.size();j++){
-            c=cols[j];
-            matrix1(r,c)=matrix2(r,c);
-        }
-    }
-}
-
 /*
  * finds all the occurrences >= a certain value in the sparse matrix
  * @pram: Sparse Matrix we read in
@@ -440,10 +178,11 @@ DT get_Max(DenseMatrix1D<DT> *matches, int id, DT val,int *row, int *col){
  * @pram: pointer to variable that is used to indicate how good matching is
  * @pram: pointer to row variable which we set to the row of the largest value
  * @pram: pointer to column variable which we set to the column of the largest value
+ * @pram: random number generator used to break ties
  */
 
 template <typename DT>
-int return_max(DenseMatrix1D<DT>& matches, DT* total_score,int* max_row,int* max_col){
+int return_max(DenseMatrix1D<DT>& matches, DT* total_score,int* max_row,int* max_col, Random& rng){
     
     DT max_so_far=-DBL_MAX;
     int max_so_far_count=1;
@@ -470,7 +209,7 @@ int return_max(DenseMatrix1D<DT>& matches, DT* total_score,int* max_row,int* max
     // to set max_row and max_col to
     
     int counter=0;
-    int random_number= rand()%max_so_far_count+1;
+    int random_number= rng.nextInt(max_so_far_count)+1;
     int set=0;
     
     for(int i=0; i<matches.getNumberOfRows();i++){
@@ -523,10 +262,10 @@ void invalidate(int row, int col, DenseMatrix1D<DT>& matches){
  * function called if matching is not complete (some nodes in graph1
  * don't get matched to any nodes in graph2)
  * @pram: an array which signifies the matching between graph1 and graph2
- * @pram: DenseMatrix1D representing graph1
- * @pram: DenseMatrix1D representing graph2
+ * @pram: graph1
+ * @pram: graph2
  */
-void match_rest(int* assignment, DenseMatrix1D<float>& graph1, DenseMatrix1D<float>& graph2){
+void match_rest(int* assignment, CSRGraph& graph1, CSRGraph& graph2){
     
     if(graph1.getNumberOfRows()<=graph2.getNumberOfRows()){
         int unassigned_graph1[graph1.getNumberOfRows()];
@@ -617,48 +356,6 @@ void match_rest(int* assignment, DenseMatrix1D<float>& graph1, DenseMatrix1D<flo
 }
 
 
-/*
- * returns a permutation matrix with dimensions size x size
- * @pram: size of the permutation matrix
- */
-DenseMatrix1D<float> getPermMatrix(int *ass, int ass_size,const int bigger_matrix_size){
-    DenseMatrix1D<float> ret_matrix(bigger_matrix_size,bigger_matrix_size);
-    int hold;
-    for(int i=0;i<bigger_matrix_size;i++){
-        if(i<ass_size){
-            hold=ass[i];
-            ret_matrix(i, hold)=1;
-        }
-        else{
-            ret_matrix(i, i)=1;
-        }
-        
-    }
-    return ret_matrix;
-}
-
-/*
- * looks through the std::vector of nodes and removes the
- * ones that have already been assigned
- * @pram: array showing the nodal assignments
- * @pram: std::vector filled with nodes that are neighbors of a node
- */
-void invalidate_neighbors(int* assignment, std::vector<int> neigh)
-{
-    int hold;
-    
-    
-    for(int i=0;i<neigh.size();i++)
-    {
-        hold=neigh[i];
-        if(assignment[hold]==1)
-        {
-            neigh.erase(neigh.begin()+i);
-        }
-    }
-    
-}
-
 /*
  *initializes an array to have all indices set to init_val
  *@pram: array we wish to initialize
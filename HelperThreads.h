@@ -0,0 +1,208 @@
+/*********************************************************************************
+ * This file contains the HelperThreads class, a set of threads that stay alive  *
+ * as long as the thread that owns them and run the same job next to it. The     *
+ * restarts of the matching algorithm use the helpers of the thread that runs    *
+ * the pair, so the helpers are started once per thread instead of once per      *
+ * component and their MatrixPools keep the buffers of one restart for the next  *
+ * ones, of the same pair or of the following pairs.                             *
+ *********************************************************************************/
+
+#ifndef _HelperThreads_h
+#define _HelperThreads_h
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+
+/*
+ * HelperThreads class definition and method declarations.
+ */
+class HelperThreads
+{
+private:
+    std::vector<std::thread> _threads;
+    std::mutex _lock;
+    std::condition_variable _job_posted;
+    std::condition_variable _job_done;
+    std::function<void()> _job;
+    std::exception_ptr _error;
+    long long _generation;
+    int _wanted;
+    int _running;
+    bool _exit;
+
+    HelperThreads(const HelperThreads&);
+    void operator=(const HelperThreads&);
+
+    void _helperLoop(int helper);
+
+public:
+    /**************
+     *Constructors*
+     **************/
+    HelperThreads();
+
+    /************
+     *Destructor*
+     ************/
+    ~HelperThreads();
+
+    /***********
+     *ACCESSORS*
+     ***********/
+    int getNumberOfThreads() const;
+
+    /**********
+    *OPERATIONS*
+    **********/
+    void run(int helpers, const std::function<void()>& job);
+
+    static HelperThreads& local();
+};
+
+//==========================================================CONSTRUCTORS============================================================
+/*
+ * HelperThreads constructor, no thread is started until run() needs it.
+ */
+inline HelperThreads::HelperThreads()
+{
+    this->_generation = 0;
+    this->_wanted = 0;
+    this->_running = 0;
+    this->_exit = false;
+}
+
+//==========================================================DESTRUCTOR==============================================================
+/*
+ * HelperThreads destructor, stops and joins the helpers.
+ */
+inline HelperThreads::~HelperThreads()
+{
+    {
+        std::lock_guard<std::mutex> guard(this->_lock);
+        this->_exit = true;
+    }
+    this->_job_posted.notify_all();
+    for (int t = 0; t < this->_threads.size(); t++)
+    {
+        this->_threads[t].join();
+    }
+}
+
+//===========================================================ACCESSORS===============================================================
+/*
+ * Returns the number of helper threads that were started.
+ */
+inline int HelperThreads::getNumberOfThreads() const
+{
+    return this->_threads.size();
+}
+
+//===========================================================OPERATIONS================================================================
+/*
+ * Runs job() on the calling thread and on helpers helper threads (started the first time they are needed) and
+ * returns when every call has returned. The first exception thrown by a call is rethrown here.
+ * @pram int: number of helper threads, 0 runs the job on the calling thread only
+ * @pram std::function<void()>: the job, it is called concurrently
+ */
+inline void HelperThreads::run(int helpers, const std::function<void()>& job)
+{
+    if (helpers < 1)
+    {
+        job();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(this->_lock);
+        while (this->_threads.size() < helpers)
+        {
+            this->_threads.push_back(std::thread(&HelperThreads::_helperLoop, this, (int) this->_threads.size()));
+        }
+        this->_job = job;
+        this->_error = std::exception_ptr();
+        this->_wanted = helpers;
+        this->_running = helpers;
+        this->_generation++;
+    }
+    this->_job_posted.notify_all();
+
+    std::exception_ptr own_error;
+    try
+    {
+        job();
+    }
+    catch (...)
+    {
+        own_error = std::current_exception();
+    }
+
+    std::unique_lock<std::mutex> guard(this->_lock);
+    this->_job_done.wait(guard, [this]() { return this->_running == 0; });
+    this->_job = std::function<void()>();
+    std::exception_ptr error = own_error ? own_error : this->_error;
+    guard.unlock();
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+/*
+ * Returns the helpers of the calling thread, they are stopped when the thread exits.
+ */
+inline HelperThreads& HelperThreads::local()
+{
+    static thread_local HelperThreads helpers;
+    return helpers;
+}
+
+//===========================================================PRIVATE=================================================================
+/*
+ * Waits for the jobs posted by run() and runs the ones that want this helper until the owner is destroyed.
+ * @pram int: index of the helper
+ */
+inline void HelperThreads::_helperLoop(int helper)
+{
+    long long seen = 0;
+    std::unique_lock<std::mutex> guard(this->_lock);
+    while (true)
+    {
+        this->_job_posted.wait(guard, [&]() { return this->_exit || this->_generation != seen; });
+        if (this->_exit)
+        {
+            return;
+        }
+        seen = this->_generation;
+        if (helper >= this->_wanted)
+        {
+            continue;
+        }
+
+        guard.unlock();
+        try
+        {
+            this->_job();
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> error_guard(this->_lock);
+            if (!this->_error)
+            {
+                this->_error = std::current_exception();
+            }
+        }
+        guard.lock();
+        this->_running--;
+        if (this->_running == 0)
+        {
+            this->_job_done.notify_all();
+        }
+    }
+}
+
+//===================================================================================================================================
+#endif
@@ -1,10 +1,14 @@
 /************************************************************************************
  * This is a file that is used to perform the IsoRank Algorithm.                    *
- * The Kroencker Product and the eigenvalue decomposition are done in this          *
- * file to get the scores matrix between nodal pairs. The ARPACK++ library          *
- * was used to compute the eigenvector decomposition. Greedy algorithms             *
- * to do the matchings are called in this file. Furthermore, functions used to      *
- * send and receive results of IsoRank between processors are defined in this file. *
+ * The eigenvector of the normalized Kroencker Product is assembled in this file    *
+ * from the spectral caches of the two graphs (SpectralCache.h, one eigensolve per  *
+ * graph instead of one per pair) to get the scores matrix between nodal pairs.     *
+ * Greedy algorithms                                                                *
+ * to do the matchings are called in this file and the matchings are scored with    *
+ * AlignmentScore.h. Every type of the scores and matching algorithm is its own     *
+ * specialization of the engine, picked at run time from a table. Furthermore,      *
+ * functions used to send and receive results of IsoRank between processors are     *
+ * defined in this file.                                                            *
  *                                                                                  *
  ************************************************************************************/
 
@@ -12,10 +16,21 @@
 #define _IsoRank_h
 
 #include "Matrices/DenseMatrix1D.h"
-#include "Tarjan.h"
+#include "Matrices/CSRGraph.h"
+#include "SpectralCache.h"
 #include "Utilities.h"
 #include "GreedyAlgorithms.h"
+#include "AlignmentScore.h"
+#include "Random.h"
+#include "PairScheduler.h"
+#include "HelperThreads.h"
 #include <vector>
+#include <chrono>
+#include <algorithm>
+#include <stdexcept>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
 #include "Matrices/MPI_Structs.h"
 
 static const int GREEDY = 0;
@@ -23,219 +38,426 @@ static const int CON_ENF_1 = 1;
 static const int CON_ENF_2 = 2;
 static const int CON_ENF_3 = 3;
 static const int CON_ENF_4 = 4;
+static const int NUM_OF_MATCHING_ALGORITHMS = 5;
+
+//types of the scores matrix that can be chosen at run time
+static const int SCORES_FLOAT = 0;
+static const int SCORES_DOUBLE = 1;
+static const int NUM_OF_SCORE_TYPES = 2;
 
 const int NUM_OF_ISORANK_IT = 20;
+
 /*
- * function used to perform the isorank algorithm
- * @pram: adjacency matrix for graph1
- * @pram: adjacency matrix for graph2
- * @pram: the matching algorithm used to choose the best node to node mapping
+ * how many restarts of the matching algorithm are run on the scores of a component. The restarts stop early
+ * when no restart can do better: when a restart made no random choice (there are no ties in the scores so
+ * every restart gives the same assignment) or when the norm is 0, both keep the result of max_restarts
+ * restarts. A patience > 0 also stops after patience restarts in a row without a smaller norm, that one
+ * can miss a better assignment.
  */
-template <typename T>
-struct IsoRank_Result isoRank(DenseMatrix1D<T>& matrix_A, DenseMatrix1D<T>& matrix_B, int matching_algorithm)
+struct RestartPolicy
 {
-    //check to see both adjacency matrices are square and symmetric
-    if (!matrix_A.isSquare() || !matrix_B.isSquare())
+    int max_restarts;
+    int patience;
+    int threads; //threads running the restarts, < 1 uses all the cores
+    
+    RestartPolicy(int max_restarts = NUM_OF_ISORANK_IT, int patience = 0, int threads = 1)
+        : max_restarts(max_restarts), patience(patience), threads(threads)
     {
-        throw NotASquareMatrixException();
     }
-    
-    if (!matrix_A.isSymmetric() || !matrix_B.isSymmetric())
+};
+
+/*
+ * the matching algorithm with a given number, match(scores, graph_A, graph_B, assignment, rng) runs it on a scores
+ * matrix (the scores are modified) and fills the assignment (-1 for unmatched nodes). The algorithm is a template
+ * argument so the restarts call it directly and the compiler can specialize it for the type of the scores.
+ */
+template <int matching_algorithm>
+struct Matcher;
+
+template <>
+struct Matcher<GREEDY>
+{
+    template <typename T>
+    static void match(DenseMatrix1D<T>& scores, CSRGraph& graph_A, CSRGraph& graph_B, int* assignment, Random& rng)
     {
-        throw NotASymmetricMatrixException();
+        greedy_1(scores,graph_A,graph_B,assignment,rng);
     }
+};
+
+template <>
+struct Matcher<CON_ENF_1>
+{
+    template <typename T>
+    static void match(DenseMatrix1D<T>& scores, CSRGraph& graph_A, CSRGraph& graph_B, int* assignment, Random& rng)
+    {
+        greedy_connectivity_1(scores,graph_A,graph_B,assignment,rng);
+    }
+};
+
+template <>
+struct Matcher<CON_ENF_2>
+{
+    template <typename T>
+    static void match(DenseMatrix1D<T>& scores, CSRGraph& graph_A, CSRGraph& graph_B, int* assignment, Random& rng)
+    {
+        greedy_connectivity_2(scores,graph_A,graph_B,assignment,rng);
+    }
+};
+
+template <>
+struct Matcher<CON_ENF_3>
+{
+    template <typename T>
+    static void match(DenseMatrix1D<T>& scores, CSRGraph& graph_A, CSRGraph& graph_B, int* assignment, Random& rng)
+    {
+        greedy_connectivity_3(scores,graph_A,graph_B,assignment,rng);
+    }
+};
+
+template <>
+struct Matcher<CON_ENF_4>
+{
+    template <typename T>
+    static void match(DenseMatrix1D<T>& scores, CSRGraph& graph_A, CSRGraph& graph_B, int* assignment, Random& rng)
+    {
+        greedy_connectivity_4(scores,graph_A,graph_B,assignment,rng);
+    }
+};
+
+/*
+ * runs the restarts of the matching algorithm on the scores of a component as allowed by a restart policy and
+ * returns the number of restarts that were counted. Every restart has its own generator seeded from restart_seed
+ * and its index and its own copy of the scores. The restarts run on the calling thread and its HelperThreads, which
+ * outlive the call, they take the next restart index from a counter and the finished restarts are checked in
+ * restart order as soon as all the ones before them are done, so the best assignment (the first one with the
+ * smallest norm) and the number of restarts do not depend on the number of threads. A thread is at most
+ * 2 * threads restarts ahead of the checked ones, the results are kept in that many slots.
+ * The matching algorithm is a template argument (see Matcher).
+ * @pram: the scores matrix of the component
+ * @pram: CSR form of graph1
+ * @pram: CSR form of graph2
+ * @pram: seed of the generators of the restarts
+ * @pram: the restart policy
+ * @pram: the smallest norm that was found
+ * @pram: the assignment of the smallest norm that gets filled
+ */
+template <typename T, int matching_algorithm>
+int run_restarts(const DenseMatrix1D<T>& scores, CSRGraph& graph_A, CSRGraph& graph_B,
+                 unsigned long long restart_seed, const RestartPolicy& policy, float* best_frob_norm, int* best_assignment)
+{
+    int nodes = graph_A.getNumberOfNodes();
+    int max_restarts = std::max(policy.max_restarts, 1);
+    int num_threads = (policy.threads < 1) ? PairScheduler::defaultNumberOfThreads() : policy.threads;
+    num_threads = std::min(num_threads, max_restarts);
+    int window = 2 * num_threads;
+    
+    //scratch buffers borrowed from the MatrixPool: the assignment, norm and number of random choices of every
+    //slot, restart r uses slot r % window
+    PooledArray<int> assignments((size_t) window * nodes);
+    PooledArray<float> frob_norms(window);
+    PooledArray<int> choices(window);
+    PooledArray<char> finished(window, 0);
+    
+    //the bitset rows of A score the restarts with popcounts, they are shared by the threads
+    BitsetGraph bits_A = (nodes <= BITSET_GRAPH_MAX_NODES) ? BitsetGraph(graph_A) : BitsetGraph();
     
-    // Degree distribution statistics
-    DenseMatrix1D<T> kron_prod = matrix_A.kron(matrix_B);
-    std::vector<vertex*> vertices = graph_con_com(kron_prod);
-    T** eigenValues = new T*[kron_prod.getNumberOfColumns()];
-    std::vector<std::vector<int>*> comp_mask_values (kron_prod.getNumberOfColumns());
+    std::mutex lock;
+    std::condition_variable slot_checked;
+    std::exception_ptr error;
+    int next_restart = 0;
+    int restarts = 0;
+    int without_improvement = 0;
+    bool stop = false;
+    *best_frob_norm=DBL_MAX;
     
-    //for each component find the eigenvector corresponding to the scores matrix
-    for(int i=0; i < kron_prod.getNumberOfColumns(); i++ )
+    //checks the finished restarts that follow the checked ones, called with the lock held
+    auto check_finished = [&]()
     {
-        std::vector<int>* comp_mask = component_mask(vertices, i);
-        comp_mask_values[i] = comp_mask;
-        if (comp_mask == NULL)
+        while (!stop && restarts < next_restart && finished[restarts % window])
         {
-	  		eigenValues[i]=NULL;
-            continue;
-        }
-        
-        DenseMatrix1D<T> L = kron_prod.getScatteredSelection(*comp_mask,*comp_mask);
-        
-        std::vector<T> sum = L.getSumOfRows();
-        std::vector<T> D_neg1(sum.size());
-        std::vector<T> D_0pt5(sum.size());
-        std::vector<T> D_neg0pt5(sum.size());
-        
-        for(int j=0; j < sum.size(); j++)
-        {
-            D_neg1[j] = 1.0/sum[j];
-            D_0pt5[j] = sqrt(sum[j]);
-            D_neg0pt5[j] = 1.0/D_0pt5[j];
-        }
-        
-        DenseMatrix1D<T> lTimesD = L.diagonalVectorTimesMatrix(D_neg0pt5);
-        DenseMatrix1D<T> Ms = lTimesD.matrixTimesDiagonalVector(D_neg0pt5);
-        
-        if(!Ms.isSymmetric())
-        {
-            throw NotASymmetricMatrixException();
-        }
-        
-        T* eigenVec=  Ms.getTopEigenVector();
-        double vecLength = 0;
-        for (int j=0; j < L.getNumberOfRows(); j++)
-        {
-            eigenVec[j] *= D_0pt5[j];
-            vecLength += pow(eigenVec[j],2);
+            int slot = restarts % window;
+            finished[slot] = 0;
+            restarts++;
+            if (frob_norms[slot] < *best_frob_norm)
+            {
+                *best_frob_norm = frob_norms[slot];
+                std::copy(assignments.data() + (size_t) slot * nodes, assignments.data() + (size_t) (slot + 1) * nodes, best_assignment);
+                without_improvement = 0;
+            }
+            else
+            {
+                without_improvement++;
+            }
+            stop = choices[slot] == 0 || *best_frob_norm == 0 || (policy.patience > 0 && without_improvement >= policy.patience);
         }
-        vecLength = sqrt(vecLength);
-        
-        int coef = 1;
-        if( eigenVec[0] < 0)
+        stop = stop || restarts >= max_restarts;
+    };
+    
+    //the scores are copied into the thread's own matrix for every restart, the matrix and the scratch of the
+    //matching algorithm come from the pool of the thread and are reused by its next restarts
+    auto restart_worker = [&]()
+    {
+        try
         {
-            coef = -1;
+            DenseMatrix1D<T> thread_scores(scores);
+            while (true)
+            {
+                int restart;
+                {
+                    std::unique_lock<std::mutex> guard(lock);
+                    slot_checked.wait(guard, [&]() { return stop || next_restart >= max_restarts || next_restart < restarts + window; });
+                    if (stop || next_restart >= max_restarts)
+                    {
+                        return;
+                    }
+                    restart = next_restart++;
+                }
+                
+                int slot = restart % window;
+                thread_scores = scores;
+                int* assignment = assignments.data() + (size_t) slot * nodes;
+                init_array(assignment,nodes,-1);
+                Random restart_rng(Random::pairSeed(restart_seed, restart, -1));
+                
+                Matcher<matching_algorithm>::match(thread_scores,graph_A,graph_B,assignment,restart_rng);
+                
+                //find the frobenius norm of A - P A P^T from the edges of A,
+                //A is padded with the identity when it is smaller than B
+                if (bits_A.getNumberOfNodes() == nodes)
+                {
+                    frob_norms[slot]=alignment_frob_norm<T>(graph_A,bits_A,assignment,graph_B.getNumberOfNodes());
+                }
+                else
+                {
+                    frob_norms[slot]=alignment_frob_norm<T>(graph_A,assignment,graph_B.getNumberOfNodes());
+                }
+                choices[slot]=restart_rng.getNumberOfChoices();
+                
+                std::lock_guard<std::mutex> guard(lock);
+                finished[slot] = 1;
+                check_finished();
+                slot_checked.notify_all();
+            }
         }
-        
-        for (int j=0; j < L.getNumberOfRows(); j++)
+        catch (...)
         {
-            eigenVec[j] = coef* (eigenVec[j]/vecLength);
+            std::lock_guard<std::mutex> guard(lock);
+            if (!error)
+            {
+                error = std::current_exception();
+            }
+            stop = true;
+            slot_checked.notify_all();
         }
-        eigenValues[i] = eigenVec;
+    };
+    
+    HelperThreads::local().run(num_threads - 1, restart_worker);
+    
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+    return restarts;
+}
+
+/*
+ * the isorank algorithm on two graphs in CSR form for one type of the scores (T) and one matching algorithm, every
+ * pair of them is its own specialization. The engines are picked at run time with find_isoRank_engine.
+ * @pram: CSR form of graph1 (built once when the graph is loaded, or a view of a GraphPack)
+ * @pram: CSR form of graph2
+ * @pram: spectral cache of graph1 (built once when the graph is loaded)
+ * @pram: spectral cache of graph2
+ * @pram: random number generator of this pair of graphs, the restarts of the matching algorithm are seeded from it
+ * @pram: how many restarts of the matching algorithm are run and on how many threads
+ */
+template <typename T, int matching_algorithm>
+struct IsoRank_Result isoRank_engine(CSRGraph& graph_A, CSRGraph& graph_B, const SpectralCache& cache_A, const SpectralCache& cache_B,
+                                     Random& rng, const RestartPolicy& restart_policy)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    
+    //check to see both graphs are undirected
+    if (!graph_A.isSymmetric() || !graph_B.isSymmetric())
+    {
+        throw NotASymmetricMatrixException();
     }
     
+    // The components of the product graph are planned from the components of the two graphs, the product is not built
+    std::vector<ProductComponent> plan;
+    plan_product_components(cache_A, cache_B, plan);
     
-    DenseMatrix1D<T> scores;
-    std::vector<int>* comp_mask_curr=comp_mask_values[0];
-    int counter_eig_vector=0;
-    int counter_comp_mask=0;
+    DenseMatrix1D<T> scores(graph_A.getNumberOfNodes(), graph_B.getNumberOfNodes());
     struct IsoRank_Result ret_val;
+    ret_val.frob_norm = 0;
+    ret_val.assignment_length = 0;
+    ret_val.assignments = NULL;
+    ret_val.restarts = 0;
     
-    //run matching algorithms for each component
-    for(int k=0;k<kron_prod.getNumberOfColumns();k++) {
-        T* eigenvector=eigenValues[k];
+    //for each component find the scores matrix and run the matching algorithm
+    for(int k=0;k<plan.size();k++) {
+        bool has_scores = cached_top_eigen_matrix(cache_A, cache_B, plan[k], scores);
         
-        if(eigenvector!=NULL) {
-            comp_mask_curr=comp_mask_values[k];
-            scores= reshape(eigenvector,matrix_A.getNumberOfRows(),matrix_B.getNumberOfColumns(),*comp_mask_curr);
-            DenseMatrix1D<T> scores_copy(scores);
-            int * best_assignment;
-            float best_frob_norm=DBL_MAX;
-            
-            for (int num_it = 0; num_it < NUM_OF_ISORANK_IT; num_it++){
-                scores=scores_copy;
-                int* assignment= new int[matrix_A.getNumberOfRows()];
-                init_array(assignment,matrix_A.getNumberOfRows(),-1);
-                
-                //call the approprite matching algorithm
-                switch (matching_algorithm)
-                {
-                    case GREEDY:
-                        greedy_1(scores,matrix_A,matrix_B,assignment);
-                        break;
-                    case CON_ENF_1:
-                        greedy_connectivity_1(scores,matrix_A,matrix_B,assignment);
-                        break;
-                    case CON_ENF_2:
-                        greedy_connectivity_2(scores,matrix_A,matrix_B,assignment);
-                        break;
-                    case CON_ENF_3:
-                        greedy_connectivity_3(scores,matrix_A,matrix_B,assignment);
-                        break;
-                    case CON_ENF_4:
-                        greedy_connectivity_4(scores,matrix_A,matrix_B,assignment);
-                        break;
-                    default:
-                        break;
-                }
-                
-                
-                //find the frobenius norm
-                // two cases: matrixA is larger than matrixB and matrixA is smaller than matrixB
-                if(matrix_A.getNumberOfRows()>matrix_B.getNumberOfRows()){
-                    DenseMatrix1D<T> perm_mat=getPermMatrix(assignment,matrix_A.getNumberOfRows(),matrix_A.getNumberOfRows());
-                    DenseMatrix1D<T> product=perm_mat*matrix_A;
-                    DenseMatrix1D<T> get_transpose=perm_mat.transpose();
-                    DenseMatrix1D<T> final_mat=product*get_transpose;
-                    DenseMatrix1D<T> ret_matrix= matrix_A-final_mat;
-					
-                    T frob_norm_hold=ret_matrix.getFrobNorm();
-                    
-                    if(frob_norm_hold<best_frob_norm){
-                        best_frob_norm=frob_norm_hold;
-                        if(num_it>0)
-                            delete []best_assignment;
-                        best_assignment=assignment;
-                        
-                    }
-                    else{
-                        delete []assignment;
-                    }
-                }
-                else{
-                    int b_size=matrix_B.getNumberOfRows();
-                    int a_size=matrix_A.getNumberOfRows();
-                    DenseMatrix1D<float> matrix_A2(b_size,b_size);
-                    
-                    for(int r=0;r<b_size;r++){
-                        for(int s=0;s<b_size;s++){
-                            if(r<a_size&&s<a_size){
-                                matrix_A2(r,s)=matrix_A(r,s);
-                            }
-                            else if(r==s){
-                                matrix_A2(r,s)=1;
-                            }
-                            else{
-                                matrix_A2(r,s)=0;
-                            }
-                        }
-                    }
-                    
-                    DenseMatrix1D<T> perm_mat=getPermMatrix(assignment,matrix_A.getNumberOfRows(),matrix_B.getNumberOfRows());
-                    DenseMatrix1D<T> product=perm_mat*matrix_A2;	
-                    DenseMatrix1D<T> get_transpose=perm_mat.transpose();
-                    DenseMatrix1D<T> final_mat=product*get_transpose;
-                    DenseMatrix1D<T> ret_matrix= matrix_A-final_mat;
-                    
-                    float frob_norm_hold=ret_matrix.getFrobNorm(); 
-                    
-                    if(frob_norm_hold<best_frob_norm){
-                        best_frob_norm=frob_norm_hold;
-                        if(num_it>0)
-                            delete []best_assignment;
-                        best_assignment=assignment;
-                    }
-                    else{
-                        delete []assignment;
-                    }
-                }
-            }
+        if(has_scores) {
+            //the restarts of every component get their own seeds from the generator of the pair,
+            //the two halves are drawn in separate statements so the order does not depend on the compiler
+            unsigned long long seed_high = rng.next();
+            unsigned long long seed_low = rng.next();
+            unsigned long long restart_seed = (seed_high << 32) | seed_low;
+            float best_frob_norm;
+            int* best_assignment = new int[graph_A.getNumberOfNodes()];
+            ret_val.restarts += run_restarts<T, matching_algorithm>(scores, graph_A, graph_B, restart_seed, restart_policy,
+                                                                    &best_frob_norm, best_assignment);
             
+            //only the last component is returned
+            if (ret_val.assignments != NULL)
+                delete []ret_val.assignments;
             ret_val.frob_norm=best_frob_norm;
             ret_val.assignments=best_assignment;
-            ret_val.assignment_length=matrix_A.getNumberOfRows();        
+            ret_val.assignment_length=graph_A.getNumberOfNodes();        
         }
+        
+        //the next component is written into a matrix of zeros
+        clear_product_component(cache_A, cache_B, plan[k], scores);
     }
     
-	for(int k=0;k<kron_prod.getNumberOfColumns();k++)
-	{
-        delete []eigenValues[k];
-	}
-    
-    for (int i = 0 ; i < comp_mask_values.size(); ++i )
+    ret_val.runtime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return ret_val;
+}
+
+/*
+ * an isoRank_engine specialization
+ */
+typedef struct IsoRank_Result (*IsoRankEngine)(CSRGraph& graph_A, CSRGraph& graph_B, const SpectralCache& cache_A,
+                                               const SpectralCache& cache_B, Random& rng, const RestartPolicy& restart_policy);
+
+/*
+ * returns the engine of a type of the scores (any type) and a matching algorithm, NULL for an unknown algorithm
+ * @pram: the matching algorithm
+ */
+template <typename T>
+IsoRankEngine isoRank_engine_of(int matching_algorithm)
+{
+    switch (matching_algorithm)
     {
-        delete  comp_mask_values[i];
+        case GREEDY:
+            return isoRank_engine<T, GREEDY>;
+        case CON_ENF_1:
+            return isoRank_engine<T, CON_ENF_1>;
+        case CON_ENF_2:
+            return isoRank_engine<T, CON_ENF_2>;
+        case CON_ENF_3:
+            return isoRank_engine<T, CON_ENF_3>;
+        case CON_ENF_4:
+            return isoRank_engine<T, CON_ENF_4>;
+        default:
+            return NULL;
     }
-    
-    for (int i=0; i < vertices.size() ; i++)
+}
+
+/*
+ * returns the engine of a type of the scores chosen at run time (SCORES_FLOAT or SCORES_DOUBLE) and a matching
+ * algorithm from the table of the specializations that are built, NULL if there is none
+ * @pram: type of the scores
+ * @pram: the matching algorithm
+ */
+inline IsoRankEngine find_isoRank_engine(int score_type, int matching_algorithm)
+{
+    static const IsoRankEngine engines[NUM_OF_SCORE_TYPES][NUM_OF_MATCHING_ALGORITHMS] =
+    {
+        {isoRank_engine<float, GREEDY>, isoRank_engine<float, CON_ENF_1>, isoRank_engine<float, CON_ENF_2>,
+         isoRank_engine<float, CON_ENF_3>, isoRank_engine<float, CON_ENF_4>},
+        {isoRank_engine<double, GREEDY>, isoRank_engine<double, CON_ENF_1>, isoRank_engine<double, CON_ENF_2>,
+         isoRank_engine<double, CON_ENF_3>, isoRank_engine<double, CON_ENF_4>}
+    };
+    if (score_type < 0 || score_type >= NUM_OF_SCORE_TYPES || matching_algorithm < 0 || matching_algorithm >= NUM_OF_MATCHING_ALGORITHMS)
     {
-    	delete vertices[i];
+        return NULL;
+    }
+    return engines[score_type][matching_algorithm];
+}
+
+/*
+ * function used to perform the isorank algorithm on two graphs in CSR form, T is the type of the scores.
+ * The engine of the matching algorithm is looked up once per pair, an unknown algorithm throws std::invalid_argument.
+ * @pram: CSR form of graph1 (built once when the graph is loaded, or a view of a GraphPack)
+ * @pram: CSR form of graph2
+ * @pram: spectral cache of graph1 (built once when the graph is loaded)
+ * @pram: spectral cache of graph2
+ * @pram: the matching algorithm used to choose the best node to node mapping
+ * @pram: random number generator of this pair of graphs, the restarts of the matching algorithm are seeded from it
+ * @pram: how many restarts of the matching algorithm are run and on how many threads
+ */
+template <typename T>
+struct IsoRank_Result isoRank(CSRGraph& graph_A, CSRGraph& graph_B, const SpectralCache& cache_A, const SpectralCache& cache_B,
+                              int matching_algorithm, Random& rng, const RestartPolicy& restart_policy = RestartPolicy())
+{
+    IsoRankEngine engine = isoRank_engine_of<T>(matching_algorithm);
+    if (engine == NULL)
+    {
+        throw std::invalid_argument("unknown matching algorithm");
+    }
+    return engine(graph_A, graph_B, cache_A, cache_B, rng, restart_policy);
+}
+
+/*
+ * function used to perform the isorank algorithm on two graphs in CSR form that do not have a spectral cache yet
+ * @pram: CSR form of graph1
+ * @pram: CSR form of graph2
+ * @pram: the matching algorithm used to choose the best node to node mapping
+ * @pram: random number generator of this pair of graphs, the restarts of the matching algorithm are seeded from it
+ * @pram: how many restarts of the matching algorithm are run and on how many threads
+ */
+template <typename T>
+struct IsoRank_Result isoRank(CSRGraph& graph_A, CSRGraph& graph_B, int matching_algorithm, Random& rng,
+                              const RestartPolicy& restart_policy = RestartPolicy())
+{
+    SpectralCache cache_A(graph_A);
+    SpectralCache cache_B(graph_B);
+    return isoRank<T>(graph_A, graph_B, cache_A, cache_B, matching_algorithm, rng, restart_policy);
+}
+
+/*
+ * function used to perform the isorank algorithm
+ * @pram: adjacency matrix for graph1
+ * @pram: adjacency matrix for graph2
+ * @pram: CSR form of graph1 (built once when the graph is loaded)
+ * @pram: CSR form of graph2 (built once when the graph is loaded)
+ * @pram: the matching algorithm used to choose the best node to node mapping
+ * @pram: random number generator of this pair of graphs, the restarts of the matching algorithm are seeded from it
+ * @pram: how many restarts of the matching algorithm are run and on how many threads
+ */
+template <typename T>
+struct IsoRank_Result isoRank(DenseMatrix1D<T>& matrix_A, DenseMatrix1D<T>& matrix_B, CSRGraph& graph_A, CSRGraph& graph_B, int matching_algorithm, Random& rng,
+                              const RestartPolicy& restart_policy = RestartPolicy())
+{
+    //check to see both adjacency matrices are square and symmetric
+    if (!matrix_A.isSquare() || !matrix_B.isSquare())
+    {
+        throw NotASquareMatrixException();
     }
     
-    delete []eigenValues;
-    return ret_val;
+    if (!matrix_A.isSymmetric() || !matrix_B.isSymmetric())
+    {
+        throw NotASymmetricMatrixException();
+    }
+    return isoRank<T>(graph_A, graph_B, matching_algorithm, rng, restart_policy);
+}
+
+/*
+ * function used to perform the isorank algorithm on two graphs that do not have a CSR form yet
+ * @pram: adjacency matrix for graph1
+ * @pram: adjacency matrix for graph2
+ * @pram: the matching algorithm used to choose the best node to node mapping
+ * @pram: random number generator of this pair of graphs, the restarts of the matching algorithm are seeded from it
+ * @pram: how many restarts of the matching algorithm are run and on how many threads
+ */
+template <typename T>
+struct IsoRank_Result isoRank(DenseMatrix1D<T>& matrix_A, DenseMatrix1D<T>& matrix_B, int matching_algorithm, Random& rng,
+                              const RestartPolicy& restart_policy = RestartPolicy())
+{
+    CSRGraph graph_A(matrix_A);
+    CSRGraph graph_B(matrix_B);
+    return isoRank(matrix_A, matrix_B, graph_A, graph_B, matching_algorithm, rng, restart_policy);
 }
 
 #endif
@@ -0,0 +1,237 @@
+/*********************************************************************************
+ * Packed bitset graph Data Structure. Every row of the adjacency matrix is kept *
+ * as a bitset of one 64 bit word per 64 nodes, so the neighbors two nodes have  *
+ * in common, the neighbors of a node that are in a set of nodes (e.g. the ones  *
+ * already assigned) and the entries where a row disagrees with another 0/1 row  *
+ * are counted with AND/XOR and popcount (kernel_and_popcount and                *
+ * kernel_xor_popcount of MatrixKernels.h) in O(n / 64). The graph takes n^2/8   *
+ * bytes, it is meant for graphs of up to a few thousand nodes next to their     *
+ * CSRGraph or DenseMatrix1D.                                                    *
+ *********************************************************************************/
+
+#ifndef _BitsetGraph_h
+#define _BitsetGraph_h
+
+#include <iostream>
+#include <vector>
+#include "MatrixExceptions.h"
+#include "MatrixKernels.h"
+#include "DenseMatrix1D.h"
+#include "CSRGraph.h"
+
+//graphs with more nodes are not worth a bitset (n^2/8 bytes)
+static const int BITSET_GRAPH_MAX_NODES = 4096;
+
+/*
+ * BitsetGraph class definition and method declarations.
+ */
+class BitsetGraph
+{
+protected:
+    int _nodes;
+    int _words;
+    int _edges;
+    std::vector<unsigned long long> _bits;
+
+public:
+    /**************
+     *Constructors*
+     **************/
+    BitsetGraph(int nodes = 0);
+    explicit BitsetGraph(const CSRGraph&);
+    template <typename T>
+    explicit BitsetGraph(DenseMatrix1D<T>&);
+
+    /***********
+     *ACCESSORS*
+     ***********/
+    int getNumberOfNodes() const;
+    int getNumberOfWords() const;
+    int getNumberOfEdges() const;
+    int getDegree(int vertex) const;
+    const unsigned long long* getRow(int vertex) const;
+    bool hasEdge(int i, int j) const;
+    int commonNeighbors(int i, int j) const;
+    int countNeighbors(int vertex, const unsigned long long* nodes) const;
+    int countMismatches(int vertex, const unsigned long long* row) const;
+
+    /**********
+    *OPERATIONS*
+    **********/
+    void addEdge(int i, int j);
+
+    /**********
+     *OPERATORS*
+     **********/
+    int operator()(int i, int j) const;
+};
+
+//==========================================================CONSTRUCTORS============================================================
+/*
+ * Constructor:
+ * Construct a graph with the given number of nodes and no edges.
+ * @pram int nodes: number of nodes, default value is 0
+ */
+inline BitsetGraph::BitsetGraph(int nodes)
+{
+    this->_nodes = nodes;
+    this->_words = (nodes + 63) / 64;
+    this->_edges = 0;
+    this->_bits.assign((size_t) nodes * this->_words, 0);
+}
+
+/*
+ * Constructor:
+ * Construct the bitset rows of a CSRGraph, O(n^2/64 + |E|).
+ * @pram CSRGraph
+ */
+inline BitsetGraph::BitsetGraph(const CSRGraph& graph)
+{
+    *this = BitsetGraph(graph.getNumberOfNodes());
+    for (int i = 0; i < this->_nodes; i++)
+    {
+        for (const int* j = graph.neighborsBegin(i); j != graph.neighborsEnd(i); j++)
+        {
+            this->addEdge(i, *j);
+        }
+    }
+}
+
+/*
+ * Constructor:
+ * Construct a graph from the non-zero entries of an adjacency matrix.
+ * @pram DenseMatrix1D<T>: square adjacency matrix
+ */
+template <typename T>
+inline BitsetGraph::BitsetGraph(DenseMatrix1D<T>& matrix)
+{
+    if (!matrix.isSquare())
+    {
+        throw NotASquareMatrixException();
+    }
+
+    *this = BitsetGraph(matrix.getNumberOfRows());
+    for (int i = 0; i < this->_nodes; i++)
+    {
+        for (int j = 0; j < this->_nodes; j++)
+        {
+            if (matrix(i, j) != 0)
+            {
+                this->addEdge(i, j);
+            }
+        }
+    }
+}
+
+//===========================================================ACCESSORS===============================================================
+/*
+ * Returns the number of nodes.
+ */
+inline int BitsetGraph::getNumberOfNodes() const
+{
+    return this->_nodes;
+}
+
+/*
+ * Returns the number of 64 bit words of a row.
+ */
+inline int BitsetGraph::getNumberOfWords() const
+{
+    return this->_words;
+}
+
+/*
+ * Returns the number of non-zero entries of the adjacency matrix (each undirected edge is counted twice).
+ */
+inline int BitsetGraph::getNumberOfEdges() const
+{
+    return this->_edges;
+}
+
+/*
+ * Returns the number of neighbors of a node, O(n / 64).
+ * @pram int vertex
+ */
+inline int BitsetGraph::getDegree(int vertex) const
+{
+    return kernel_and_popcount(this->getRow(vertex), this->getRow(vertex), this->_words);
+}
+
+/*
+ * Returns a pointer to the bitset of the neighbors of a node (getNumberOfWords() words, node j is bit j % 64 of word
+ * j / 64).
+ * @pram int vertex
+ */
+inline const unsigned long long* BitsetGraph::getRow(int vertex) const
+{
+    return this->_bits.data() + (size_t) vertex * this->_words;
+}
+
+/*
+ * Returns true if there is an edge between i and j, O(1).
+ * @pram int i
+ * @pram int j
+ */
+inline bool BitsetGraph::hasEdge(int i, int j) const
+{
+    return (this->getRow(i)[j / 64] >> (j % 64)) & 1;
+}
+
+/*
+ * Returns the number of neighbors i and j have in common, O(n / 64).
+ * @pram int i
+ * @pram int j
+ */
+inline int BitsetGraph::commonNeighbors(int i, int j) const
+{
+    return kernel_and_popcount(this->getRow(i), this->getRow(j), this->_words);
+}
+
+/*
+ * Returns the number of neighbors of a node that are in a set of nodes, e.g. how many of its neighbors are already
+ * assigned, O(n / 64).
+ * @pram int vertex
+ * @pram const unsigned long long*: bitset of the set of nodes (getNumberOfWords() words)
+ */
+inline int BitsetGraph::countNeighbors(int vertex, const unsigned long long* nodes) const
+{
+    return kernel_and_popcount(this->getRow(vertex), nodes, this->_words);
+}
+
+/*
+ * Returns the number of entries where the row of a node and another 0/1 row disagree, O(n / 64).
+ * @pram int vertex
+ * @pram const unsigned long long*: bitset of the other row (getNumberOfWords() words)
+ */
+inline int BitsetGraph::countMismatches(int vertex, const unsigned long long* row) const
+{
+    return kernel_xor_popcount(this->getRow(vertex), row, this->_words);
+}
+
+//===========================================================OPERATIONS================================================================
+/*
+ * Adds the entry (i,j) to the adjacency matrix, call it with (j,i) too for an undirected edge.
+ * @pram int i
+ * @pram int j
+ */
+inline void BitsetGraph::addEdge(int i, int j)
+{
+    unsigned long long& word = this->_bits[(size_t) i * this->_words + j / 64];
+    unsigned long long bit = 1ULL << (j % 64);
+    this->_edges += (word & bit) ? 0 : 1;
+    word |= bit;
+}
+
+//===========================================================OPERATORS================================================================
+/*
+ * returns the entry (i,j) of the adjacency matrix
+ * @pram: int i
+ * @pram: int j
+ */
+inline int BitsetGraph::operator()(int i, int j) const
+{
+    return this->hasEdge(i, j) ? 1 : 0;
+}
+
+//===================================================================================================================================
+#endif
@@ -0,0 +1,400 @@
+/*********************************************************************************
+ * Compressed Sparse Row graph Data Structure. The neighbors of every node are   *
+ * stored next to each other (sorted) in one array and an offset array points to *
+ * the first neighbor of each node, so iterating over the neighbors of a node    *
+ * costs O(deg) instead of a scan over a whole row/column of a dense matrix.     *
+ * A graph either owns its arrays or is a view of arrays owned by someone else   *
+ * (e.g. a memory mapped GraphPack), views are never copied into new storage.    *
+ *********************************************************************************/
+
+#ifndef _CSRGraph_h
+#define _CSRGraph_h
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include "MatrixExceptions.h"
+#include "DenseMatrix1D.h"
+#include "GraphFile.h"
+
+class CSRGraph;
+
+std::ostream& operator<< (std::ostream&, const CSRGraph&);
+
+/*
+ * CSRGraph class definition and method declarations.
+ */
+class CSRGraph
+{
+private:
+    void _bindStorage();
+
+protected:
+    int _nodes;
+    int _edges;
+    std::vector<int> _row_ptr;
+    std::vector<int> _col_idx;
+    const int* _row_view;
+    const int* _col_view;
+
+public:
+    /**************
+     *Constructors*
+     **************/
+    CSRGraph(int nodes = 0);
+    CSRGraph(int nodes, int edges, const int* row_ptr, const int* col_idx);
+    CSRGraph(const CSRGraph&);
+    template <typename T>
+    explicit CSRGraph(DenseMatrix1D<T>&);
+    explicit CSRGraph(const std::string& file_path);
+
+    /************
+     *Destructor*
+     ************/
+    virtual ~CSRGraph();
+
+    /***********
+     *ACCESSORS*
+     ***********/
+    int getNumberOfRows() const;
+    int getNumberOfColumns() const;
+    int getNumberOfNodes() const;
+    int getNumberOfEdges() const;
+    int getDegree(int vertex) const;
+    const int* neighborsBegin(int vertex) const;
+    const int* neighborsEnd(int vertex) const;
+    std::vector<int> getNeighbors(int vertex) const;
+    bool hasEdge(int i, int j) const;
+    bool isView() const;
+    bool isSymmetric() const;
+    const int* getRowPointers() const;
+    const int* getColumnIndices() const;
+
+    /**********
+     *OPERATORS*
+     **********/
+    CSRGraph& operator=(const CSRGraph&);
+    int operator()(int i, int j) const;
+    friend std::ostream& operator<< (std::ostream& stream, const CSRGraph& graph);
+};
+
+//==========================================================CONSTRUCTORS============================================================
+/*
+ * Constructor:
+ * Construct a graph with the given number of nodes and no edges.
+ * @pram int nodes: number of nodes, default value is 0
+ */
+inline CSRGraph::CSRGraph(int nodes)
+{
+    this->_nodes = nodes;
+    this->_row_ptr.assign(nodes + 1, 0);
+    this->_bindStorage();
+}
+
+/*
+ * Constructor:
+ * Construct a view of CSR arrays owned by someone else, nothing is copied.
+ * The arrays must outlive the graph and every copy of it.
+ * @pram int nodes: number of nodes
+ * @pram int edges: number of non-zero entries (length of col_idx)
+ * @pram const int* row_ptr: nodes + 1 offsets into col_idx
+ * @pram const int* col_idx: sorted neighbors of every node
+ */
+inline CSRGraph::CSRGraph(int nodes, int edges, const int* row_ptr, const int* col_idx)
+{
+    this->_nodes = nodes;
+    this->_edges = edges;
+    this->_row_view = row_ptr;
+    this->_col_view = col_idx;
+}
+
+/*
+ * Copy constructor:
+ * A copy of a view is a view of the same arrays, a copy of a graph that owns its arrays owns a copy of them.
+ * @pram CSRGraph
+ */
+inline CSRGraph::CSRGraph(const CSRGraph& graph)
+{
+    *this = graph;
+}
+
+/*
+ * Constructor:
+ * Construct a graph from the non-zero entries of an adjacency matrix.
+ * @pram DenseMatrix1D<T>: square adjacency matrix
+ */
+template <typename T>
+inline CSRGraph::CSRGraph(DenseMatrix1D<T>& matrix)
+{
+    if (!matrix.isSquare())
+    {
+        throw NotASquareMatrixException();
+    }
+
+    this->_nodes = matrix.getNumberOfRows();
+    this->_row_ptr.resize(this->_nodes + 1);
+    this->_row_ptr[0] = 0;
+    for (int i = 0; i < this->_nodes; i++)
+    {
+        for (int j = 0; j < this->_nodes; j++)
+        {
+            if (matrix(i, j) != 0)
+            {
+                this->_col_idx.push_back(j);
+            }
+        }
+        this->_row_ptr[i + 1] = this->_col_idx.size();
+    }
+    this->_bindStorage();
+}
+
+/*
+ * Constructor:
+ * Construct a graph from a graph file, repeated entries are stored once.
+ * The file is parsed by GraphFile, a malformed file throws MatrixReaderException.
+ * @pram std::string : path to the file
+ */
+inline CSRGraph::CSRGraph(const std::string& file_path)
+{
+    GraphFile graph_file(file_path);
+    if (graph_file.getNumberOfRows() != graph_file.getNumberOfColumns())
+    {
+        throw NotASquareMatrixException();
+    }
+
+    //counting sort of the entries by row, then every row is sorted and made unique
+    this->_nodes = graph_file.getNumberOfRows();
+    std::vector<int> row_fill(this->_nodes + 1, 0);
+    for (int k = 0; k < graph_file.getNumberOfEntries(); k++)
+    {
+        row_fill[graph_file.getRow(k) + 1]++;
+    }
+    for (int i = 0; i < this->_nodes; i++)
+    {
+        row_fill[i + 1] += row_fill[i];
+    }
+    std::vector<int> entries(graph_file.getNumberOfEntries());
+    for (int k = 0; k < graph_file.getNumberOfEntries(); k++)
+    {
+        entries[row_fill[graph_file.getRow(k)]++] = graph_file.getColumn(k);
+    }
+
+    this->_row_ptr.resize(this->_nodes + 1);
+    this->_row_ptr[0] = 0;
+    this->_col_idx.reserve(entries.size());
+    int row_start = 0;
+    for (int i = 0; i < this->_nodes; i++)
+    {
+        int row_end = row_fill[i];
+        std::sort(entries.begin() + row_start, entries.begin() + row_end);
+        for (int k = row_start; k < row_end; k++)
+        {
+            if (k == row_start || entries[k] != entries[k - 1])
+            {
+                this->_col_idx.push_back(entries[k]);
+            }
+        }
+        this->_row_ptr[i + 1] = this->_col_idx.size();
+        row_start = row_end;
+    }
+    this->_bindStorage();
+}
+
+//==========================================================DESTRUCTOR==============================================================
+/*
+ * CSRGraph destructor.
+ */
+inline CSRGraph::~CSRGraph()
+{
+}
+
+//===========================================================ACCESSORS===============================================================
+/*
+ * Returns the number of rows of the adjacency matrix (number of nodes).
+ */
+inline int CSRGraph::getNumberOfRows() const
+{
+    return this->_nodes;
+}
+
+/*
+ * Returns the number of columns of the adjacency matrix (number of nodes).
+ */
+inline int CSRGraph::getNumberOfColumns() const
+{
+    return this->_nodes;
+}
+
+/*
+ * Returns the number of nodes.
+ */
+inline int CSRGraph::getNumberOfNodes() const
+{
+    return this->_nodes;
+}
+
+/*
+ * Returns the number of non-zero entries of the adjacency matrix (each undirected edge is counted twice).
+ */
+inline int CSRGraph::getNumberOfEdges() const
+{
+    return this->_edges;
+}
+
+/*
+ * Returns the number of neighbors of a node.
+ * @pram int vertex
+ */
+inline int CSRGraph::getDegree(int vertex) const
+{
+    return this->_row_view[vertex + 1] - this->_row_view[vertex];
+}
+
+/*
+ * Returns a pointer to the first neighbor of a node, neighbors are sorted.
+ * @pram int vertex
+ */
+inline const int* CSRGraph::neighborsBegin(int vertex) const
+{
+    return this->_col_view == NULL ? NULL : this->_col_view + this->_row_view[vertex];
+}
+
+/*
+ * Returns a pointer past the last neighbor of a node.
+ * @pram int vertex
+ */
+inline const int* CSRGraph::neighborsEnd(int vertex) const
+{
+    return this->_col_view == NULL ? NULL : this->_col_view + this->_row_view[vertex + 1];
+}
+
+/*
+ * Returns a std::vector<int> of the neighbors of a node.
+ * @pram int vertex
+ */
+inline std::vector<int> CSRGraph::getNeighbors(int vertex) const
+{
+    return std::vector<int>(this->neighborsBegin(vertex), this->neighborsEnd(vertex));
+}
+
+/*
+ * Returns true if there is an edge between i and j, O(log(deg(i))).
+ * @pram int i
+ * @pram int j
+ */
+inline bool CSRGraph::hasEdge(int i, int j) const
+{
+    return std::binary_search(this->neighborsBegin(i), this->neighborsEnd(i), j);
+}
+
+/*
+ * Returns true if the graph does not own its arrays.
+ */
+inline bool CSRGraph::isView() const
+{
+    return this->_row_view != NULL && this->_row_ptr.empty();
+}
+
+/*
+ * Returns true if every edge (i,j) has the edge (j,i), O(E log(deg)).
+ */
+inline bool CSRGraph::isSymmetric() const
+{
+    for (int i = 0; i < this->_nodes; i++)
+    {
+        for (const int* j = this->neighborsBegin(i); j != this->neighborsEnd(i); j++)
+        {
+            if (!this->hasEdge(*j, i))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/*
+ * Returns the nodes + 1 offsets of the rows into the column indices.
+ */
+inline const int* CSRGraph::getRowPointers() const
+{
+    return this->_row_view;
+}
+
+/*
+ * Returns the column indices (sorted neighbors of every node), NULL if the graph has no edges.
+ */
+inline const int* CSRGraph::getColumnIndices() const
+{
+    return this->_col_view;
+}
+
+//==========================================================OPERATORS================================================================
+/*
+ * Overloaded = operator, views stay views of the same arrays.
+ * @pram: CSRGraph
+ */
+inline CSRGraph& CSRGraph::operator=(const CSRGraph& graph)
+{
+    if (this != &graph)
+    {
+        this->_nodes = graph._nodes;
+        this->_edges = graph._edges;
+        this->_row_ptr = graph._row_ptr;
+        this->_col_idx = graph._col_idx;
+        if (graph.isView())
+        {
+            this->_row_view = graph._row_view;
+            this->_col_view = graph._col_view;
+        }
+        else
+        {
+            this->_bindStorage();
+        }
+    }
+    return *this;
+}
+
+/*
+ * Overloaded () operator, returns 1 if there is an edge between i and j and 0 otherwise.
+ * @pram: int i
+ * @pram: int j
+ */
+inline int CSRGraph::operator()(int i, int j) const
+{
+    return this->hasEdge(i, j) ? 1 : 0;
+}
+
+/*
+ * overloaded ostream operator for printing a graph
+ * @pram: std::ostream
+ * @pram: CSRGraph
+ */
+inline std::ostream& operator<<(std::ostream& stream, const CSRGraph& graph)
+{
+    stream << "Nodes: " << graph._nodes << " Edges: " << graph.getNumberOfEdges() << '\n';
+    for (int i = 0; i < graph._nodes; i++)
+    {
+        stream << i << ":";
+        for (const int* j = graph.neighborsBegin(i); j != graph.neighborsEnd(i); j++)
+        {
+            stream << ' ' << *j;
+        }
+        stream << "\n";
+    }
+    return stream;
+}
+
+//===========================================================PRIVATE=================================================================
+/*
+ * Points the views at the arrays owned by the graph, called whenever they are filled or reallocated.
+ */
+inline void CSRGraph::_bindStorage()
+{
+    this->_edges = this->_col_idx.size();
+    this->_row_view = this->_row_ptr.empty() ? NULL : &this->_row_ptr[0];
+    this->_col_view = this->_col_idx.empty() ? NULL : &this->_col_idx[0];
+}
+
+//===================================================================================================================================
+#endif
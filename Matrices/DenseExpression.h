@@ -0,0 +1,191 @@
+/*********************************************************************************
+ * Element wise expressions of dense matrices. An expression only keeps          *
+ * references to its operands and computes an entry when it is asked for it, so  *
+ * a chain like diagonal_scaling(d, lazy(L), d) or lazy(A) - lazy(B) is          *
+ * evaluated in one pass over the entries when it is assigned to a              *
+ * DenseMatrix1D or given to frob_norm, without the intermediate matrices of the *
+ * eager operators. Every entry only depends on the same entry of the operands,  *
+ * so an expression can be assigned to one of its own operands.                  *
+ * Expressions must not outlive the matrices and vectors they refer to.          *
+ *********************************************************************************/
+
+#ifndef _DenseExpression_h
+#define _DenseExpression_h
+
+#include <vector>
+#include "MatrixExceptions.h"
+
+template <typename T>
+class DenseMatrix1D;
+
+/*
+ * base of all the expressions, E is the expression type (curiously recurring template)
+ */
+template <typename E>
+class DenseExpression
+{
+public:
+    const E& self() const { return static_cast<const E&>(*this); }
+    int getNumberOfRows() const { return this->self().getNumberOfRows(); }
+    int getNumberOfColumns() const { return this->self().getNumberOfColumns(); }
+    double operator()(int i, int j) const { return this->self()(i, j); }
+};
+
+/*
+ * a matrix used in an expression
+ */
+template <typename T>
+class DenseMatrixRef : public DenseExpression<DenseMatrixRef<T> >
+{
+protected:
+    const DenseMatrix1D<T>& _matrix;
+
+public:
+    explicit DenseMatrixRef(const DenseMatrix1D<T>& matrix) : _matrix(matrix) {}
+    int getNumberOfRows() const { return this->_matrix.getNumberOfRows(); }
+    int getNumberOfColumns() const { return this->_matrix.getNumberOfColumns(); }
+    T operator()(int i, int j) const { return this->_matrix(i, j); }
+};
+
+/*
+ * entry wise sum (sign = 1) or difference (sign = -1) of two expressions
+ */
+template <typename L, typename R>
+class DenseSum : public DenseExpression<DenseSum<L, R> >
+{
+protected:
+    const L _left;
+    const R _right;
+    const int _sign;
+
+public:
+    DenseSum(const L& left, const R& right, int sign)
+        : _left(left), _right(right), _sign(sign)
+    {
+        if (left.getNumberOfRows() != right.getNumberOfRows() || left.getNumberOfColumns() != right.getNumberOfColumns())
+        {
+            throw DimensionMismatchException();
+        }
+    }
+    int getNumberOfRows() const { return this->_left.getNumberOfRows(); }
+    int getNumberOfColumns() const { return this->_left.getNumberOfColumns(); }
+    double operator()(int i, int j) const { return this->_left(i, j) + this->_sign * this->_right(i, j); }
+};
+
+/*
+ * diag(left) * E * diag(right), a NULL vector stands for the identity
+ */
+template <typename E, typename V>
+class DiagonalScaling : public DenseExpression<DiagonalScaling<E, V> >
+{
+protected:
+    const E _expression;
+    const std::vector<V>* _left;
+    const std::vector<V>* _right;
+
+public:
+    DiagonalScaling(const std::vector<V>* left, const E& expression, const std::vector<V>* right)
+        : _expression(expression), _left(left), _right(right)
+    {
+        if ((left != NULL && left->size() != expression.getNumberOfRows())
+            || (right != NULL && right->size() != expression.getNumberOfColumns()))
+        {
+            throw DimensionMismatchException();
+        }
+    }
+    int getNumberOfRows() const { return this->_expression.getNumberOfRows(); }
+    int getNumberOfColumns() const { return this->_expression.getNumberOfColumns(); }
+    double operator()(int i, int j) const
+    {
+        double value = this->_expression(i, j);
+        if (this->_left != NULL)
+        {
+            value *= (*this->_left)[i];
+        }
+        if (this->_right != NULL)
+        {
+            value *= (*this->_right)[j];
+        }
+        return value;
+    }
+};
+
+//===================================================================================================================================
+/*
+ * returns an expression of a matrix
+ * @pram: the matrix
+ */
+template <typename T>
+DenseMatrixRef<T> lazy(const DenseMatrix1D<T>& matrix)
+{
+    return DenseMatrixRef<T>(matrix);
+}
+
+/*
+ * returns the expression of the entry wise sum of two expressions
+ * @pram: left operand
+ * @pram: right operand
+ */
+template <typename L, typename R>
+DenseSum<L, R> operator+(const DenseExpression<L>& left, const DenseExpression<R>& right)
+{
+    return DenseSum<L, R>(left.self(), right.self(), 1);
+}
+
+/*
+ * returns the expression of the entry wise difference of two expressions
+ * @pram: left operand
+ * @pram: right operand
+ */
+template <typename L, typename R>
+DenseSum<L, R> operator-(const DenseExpression<L>& left, const DenseExpression<R>& right)
+{
+    return DenseSum<L, R>(left.self(), right.self(), -1);
+}
+
+/*
+ * returns the expression diag(left) * expression * diag(right)
+ * @pram: diagonal entries of the left diagonal matrix (NULL for the identity)
+ * @pram: the expression
+ * @pram: diagonal entries of the right diagonal matrix (NULL for the identity)
+ */
+template <typename E, typename V>
+DiagonalScaling<E, V> diagonal_scaling(const std::vector<V>* left, const DenseExpression<E>& expression, const std::vector<V>* right)
+{
+    return DiagonalScaling<E, V>(left, expression.self(), right);
+}
+
+/*
+ * returns the expression diag(left) * expression * diag(right)
+ * @pram: diagonal entries of the left diagonal matrix
+ * @pram: the expression
+ * @pram: diagonal entries of the right diagonal matrix
+ */
+template <typename E, typename V>
+DiagonalScaling<E, V> diagonal_scaling(const std::vector<V>& left, const DenseExpression<E>& expression, const std::vector<V>& right)
+{
+    return DiagonalScaling<E, V>(&left, expression.self(), &right);
+}
+
+/*
+ * returns the squared frobenius norm of an expression (the sum of the squares of its entries, like
+ * DenseMatrix1D::getFrobNorm) in one pass
+ * @pram: the expression
+ */
+template <typename E>
+double frob_norm(const DenseExpression<E>& expression)
+{
+    const E& entries = expression.self();
+    double ret_val = 0;
+    for (int i = 0; i < entries.getNumberOfRows(); i++)
+    {
+        for (int j = 0; j < entries.getNumberOfColumns(); j++)
+        {
+            double value = entries(i, j);
+            ret_val += value * value;
+        }
+    }
+    return ret_val;
+}
+
+#endif
@@ -1,7 +1,10 @@
 /*********************************************************************************
  * Dense Matrix Data Structure. This structure uses a one dimensional array that *
  * is dynamically allocated to hold all the values in a matrix.                  * 
- *                                                                               *
+ * The array is a 64 byte aligned buffer borrowed from the MatrixPool of the     *
+ * thread, so temporary matrices reuse the storage of the previous ones.        *
+ * The bulk operations (norm, row sums, transpose, product) use the kernels of   *
+ * MatrixKernels.h.                                                              *
  *********************************************************************************/
 
 #ifndef _DenseMatrix1D_h
@@ -16,18 +19,11 @@
 #include <fstream>
 #include "MatrixExceptions.h"
 #include "SparseElement.h"
-
-#ifdef ARPACK
-#include "dsmatrxa.h"
-#include "ardsmat.h"
-#include "ardssym.h"
-#include "lsymsol.h"
-#endif
-
-#ifdef EIGEN
-#include <Eigen/Dense>
-#include <Eigen/Sparse>
-#endif
+#include "GraphFile.h"
+#include "Lanczos.h"
+#include "MatrixPool.h"
+#include "MatrixKernels.h"
+#include "DenseExpression.h"
 
 #ifdef USE_MPI
 #include "mpi.h"
@@ -73,6 +69,9 @@ public:
     DenseMatrix1D(bool fill = true);
     DenseMatrix1D(int, int, bool fill = true);
     DenseMatrix1D(const DenseMatrix1D<T>&);
+    DenseMatrix1D(DenseMatrix1D<T>&&);
+    template <typename E>
+    DenseMatrix1D(const DenseExpression<E>&);
     DenseMatrix1D(const std::string&);
 
     #ifdef USE_MPI
@@ -90,8 +89,8 @@ public:
      ***********/
     bool isSquare();
     bool isSymmetric();
-    int getNumberOfRows();
-    int getNumberOfColumns();
+    int getNumberOfRows() const;
+    int getNumberOfColumns() const;
     std::vector<SparseElement<T> >getSparseForm();
     DenseMatrix1D<T> getScatteredSelection(const std::vector<int>& vec_A, const std::vector<int> vec_B);
     
@@ -123,7 +122,11 @@ public:
      *OPERATORS*
      **********/
     T& operator()(int i, int j);
-    void operator= (const DenseMatrix1D<T>&);
+    const T& operator()(int i, int j) const;
+    DenseMatrix1D<T>& operator= (const DenseMatrix1D<T>&);
+    DenseMatrix1D<T>& operator= (DenseMatrix1D<T>&&);
+    template <typename E>
+    DenseMatrix1D<T>& operator= (const DenseExpression<E>&);
     bool operator==(const DenseMatrix1D<T>&);
     DenseMatrix1D<T> operator+(const DenseMatrix1D<T>& other_matrix);
     DenseMatrix1D<T> operator-(const DenseMatrix1D<T>& other_matrix);
@@ -153,36 +156,21 @@ inline DenseMatrix1D<T>::DenseMatrix1D(bool fill)
 /*
  * DensMatrix constructor:
  * Construct a matrix by reading a matrix file, specified in readme.txt file the nodes that exist will have _DEFAULT_MATRIX_ENTRY value.
+ * The file is parsed by GraphFile, a malformed file throws MatrixReaderException.
  * @pram std::string : path to the file
  */
 template<typename T>
 inline DenseMatrix1D<T>::DenseMatrix1D(const std::string& file_path)
 {
-    int tmp_x;
-    int tmp_y;
-    std::ifstream file_reader;
-    file_reader.open(file_path.c_str());
-    
-    if(file_reader.fail())
-    {
-        file_reader.close();
-        throw FileDoesNotExistException(file_path.c_str());
-    }
-    
-    file_reader >> this->_rows;
-    file_reader >> this->_cols;
+    GraphFile graph_file(file_path);
+    this->_rows = graph_file.getNumberOfRows();
+    this->_cols = graph_file.getNumberOfColumns();
     
     _initializeMatrix(true);
-    file_reader >> tmp_x;      //skip the line number
-    
-    while (!file_reader.eof())
+    for (int k = 0; k < graph_file.getNumberOfEntries(); k++)
     {
-        file_reader >> tmp_x;
-        file_reader >> tmp_y;
-        (*this)(tmp_x - 1 ,tmp_y - 1) = _DEFAULT_MATRIX_ENTRY;
+        (*this)(graph_file.getRow(k), graph_file.getColumn(k)) = _DEFAULT_MATRIX_ENTRY;
     }
-    
-    file_reader.close();
 }
 
 /*
@@ -341,6 +329,37 @@ inline DenseMatrix1D<T>::DenseMatrix1D(const DenseMatrix1D<T>& matrix)
     _copy(matrix);
 }
 
+/*
+ * DensMatrix move constructor:
+ * Takes the storage of a matrix, the matrix is left empty (0*0).
+ * @pram DenseMatrix1D<T>
+ */
+template <typename T>
+inline DenseMatrix1D<T>::DenseMatrix1D(DenseMatrix1D<T>&& matrix)
+{
+    this->_rows = matrix._rows;
+    this->_cols = matrix._cols;
+    this->_edges = matrix._edges;
+    matrix._rows = 0;
+    matrix._cols = 0;
+    matrix._edges = NULL;
+}
+
+/*
+ * DensMatrix constructor:
+ * Evaluates an expression (DenseExpression.h) in one pass.
+ * @pram DenseExpression<E>
+ */
+template <typename T>
+template <typename E>
+inline DenseMatrix1D<T>::DenseMatrix1D(const DenseExpression<E>& expression)
+{
+    this->_rows = expression.getNumberOfRows();
+    this->_cols = expression.getNumberOfColumns();
+    _initializeMatrix(false);
+    *this = expression;
+}
+
 //==========================================================DESTRUCTOR==============================================================
 /*
  * DenseMatrix destructor:
@@ -349,7 +368,7 @@ inline DenseMatrix1D<T>::DenseMatrix1D(const DenseMatrix1D<T>& matrix)
 template <typename T>
 inline DenseMatrix1D<T>::~DenseMatrix1D()
 {
-    delete [] this->_edges;
+    MatrixPool::release(this->_edges, this->_getArrSize() * sizeof(T));
 }
 
 //===========================================================ACCESSORS===============================================================
@@ -357,7 +376,7 @@ inline DenseMatrix1D<T>::~DenseMatrix1D()
  * Returns the number of the rows.
  */
 template <typename T>
-inline int DenseMatrix1D<T>::getNumberOfRows()
+inline int DenseMatrix1D<T>::getNumberOfRows() const
 {
     return this->_rows;
 }
@@ -366,7 +385,7 @@ inline int DenseMatrix1D<T>::getNumberOfRows()
  * Returns the number of the columns.
  */
 template <typename T>
-inline int DenseMatrix1D<T>::getNumberOfColumns()
+inline int DenseMatrix1D<T>::getNumberOfColumns() const
 {
     return this->_cols;
 }
@@ -392,12 +411,13 @@ inline bool DenseMatrix1D<T>::isSymmetric()
         return false;
     }
     
-    //checking for entries to be equal
+    //checking for entries to be equal, every pair is compared once
     for(int i = 0; i < this->_rows; i++)
     {
-        for(int j = 0; j < this->_cols; j++)
+        const T* row = this->_edges + (size_t) i * this->_cols;
+        for(int j = i + 1; j < this->_cols; j++)
         {
-            if (this->_edges[(i * this->_cols) + j] != this->_edges[(j * this->_cols) + i])
+            if (row[j] != this->_edges[(size_t) j * this->_cols + i])
             {
                 return false;
             }
@@ -414,11 +434,15 @@ template <typename T>
 inline std::vector<SparseElement<T> > DenseMatrix1D<T>::getSparseForm()
 {    
     std::vector<SparseElement<T> > sparse_form;
-    for(int i = 0; i < this->_getArrSize(); i++)
+    for(int i = 0; i < this->_rows; i++)
     {
-        if(this->_edges[i] != 0)
+        const T* row = this->_edges + (size_t) i * this->_cols;
+        for(int j = 0; j < this->_cols; j++)
         {
-            sparse_form.push_back(SparseElement<T>(i/this->_cols, i%this->_cols, this->_edges[i]));
+            if(row[j] != 0)
+            {
+                sparse_form.push_back(SparseElement<T>(i, j, row[j]));
+            }
         }
     }
     return sparse_form;
@@ -479,76 +503,38 @@ inline DenseMatrix1D<T> DenseMatrix1D<T>::getScatteredSelection(const std::vecto
 template <typename T>
 inline T DenseMatrix1D<T>::getFrobNorm()
 {
-    T ret_val = 0;
-    for (int i = 0; i < this->_getArrSize(); i++)
-    {
-        ret_val += this->_edges[i] * this->_edges[i];
-    }
-
-    return ret_val;
+    return kernel_sum_of_squares(this->_edges, this->_getArrSize());
 }
 
 /*
- * Returns a std::vector<T> that contains the values of the eigenvector associated to the largest eigenvalue
+ * Returns an array (delete [] it after usage) that contains the values of the eigenvector associated to the largest eigenvalue,
+ * found with the Lanczos solver of Lanczos.h.
  */
 template <typename T>
 inline T* DenseMatrix1D<T>::getTopEigenVector()
 {
-#ifdef ARPACK
-    int arr_size = (0.5 * this->_rows * (this->_rows+1));
-    T sym_edges[arr_size];
-    int counter = 0;
-    
-    for(int i = 0; i < this->_rows; i++)
+    //y = A x on the full matrix, the start vector of ones is not orthogonal to the Perron vector
+    auto apply = [this](const double* x, double* y)
     {
-        for(int j = i; j < this->_cols; j++)
-        {
-            sym_edges[counter] = this->_edges[i * this->_cols +j];
-            counter++;
-        }
-    }
-    
-    ARdsSymMatrix<T> ARMatrix(this->_rows, sym_edges, 'L');
-    ARluSymStdEig<T> eigProb(1, ARMatrix, "LM", 10);
-    eigProb.FindEigenvectors();
-    T* eigen_vector = new T[this->_rows];
-     
-    for (int i=0; i < this->_rows ; i++)
-    {
-        eigen_vector[i] = eigProb.Eigenvector(0,i);
-    }
-    return eigen_vector;
-#endif
-
-#ifdef EIGEN
-    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> A_eigen = Eigen::MatrixXd::Zero(this->_rows, this->_cols);
-    for (long i=0; i< this->_rows; i++) 
-    {
-        for(int j = 0; j < this->_cols; j++)
-        {
-            A_eigen(i,j) = this->_edges[i * this->_cols +j];
-        }
-    }
-    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es;
-    es.compute(A_eigen);
-    
-    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> evals_eigen = es.eigenvalues();
-    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> evecs_eigen = es.eigenvectors();
-    T* eigen_vector = new T[this->_rows];
-
-    for ( int i=0; i < this->_cols; i++)
-    {   
-        if (evals_eigen(i) == evals_eigen.maxCoeff())
+        for (int i = 0; i < this->_rows; i++)
         {
-            for (int j= 0; j < this->_rows ; j++)
+            double sum = 0;
+            for (int j = 0; j < this->_rows; j++)
             {
-                eigen_vector[j] = evecs_eigen(j,i);
+                sum += this->_edges[i * this->_cols + j] * x[j];
             }
-            break;
+            y[i] = sum;
         }
+    };
+    std::vector<double> top(this->_rows, 1.0);
+    lanczos_top_eigen(apply, top);
+
+    T* eigen_vector = new T[this->_rows];
+    for (int i = 0; i < this->_rows; i++)
+    {
+        eigen_vector[i] = top[i];
     }
     return eigen_vector;
-#endif
 }
 
 /*
@@ -557,15 +543,13 @@ inline T* DenseMatrix1D<T>::getTopEigenVector()
 template <typename T>
 DenseMatrix1D<T> DenseMatrix1D<T>::transpose()
 {
-    DenseMatrix1D<T> ret_matrix(this->_rows,this->_cols);
+    DenseMatrix1D<T> ret_matrix(this->_cols,this->_rows,false);
 
-    for(int i=0;i<this->_rows;i++)
-    {
-        for(int j=0;j<this->_cols;j++)
-        {
-            ret_matrix._edges[j * ret_matrix._cols + i] = this->_edges[i *this->_cols + j];
-        }
-    }
+    PooledArray<const T*> rows(this->_rows);
+    PooledArray<T*> ret_rows(ret_matrix._rows);
+    row_pointers(this->_edges, this->_rows, this->_cols, rows.data());
+    row_pointers(ret_matrix._edges, ret_matrix._rows, ret_matrix._cols, ret_rows.data());
+    kernel_transpose(rows.data(), ret_rows.data(), this->_rows, this->_cols);
     return ret_matrix;
 }
 
@@ -578,10 +562,9 @@ template <typename T>
 inline std::vector<T> DenseMatrix1D<T>::getSumOfRows()
 {
     std::vector<T> sum_vector(this->_rows);
-    for(int i = 0; i < this->_getArrSize(); i++)
-    {
-        sum_vector[(i / this->_rows)] += this->_edges[i];
-    }
+    PooledArray<const T*> rows(this->_rows);
+    row_pointers(this->_edges, this->_rows, this->_cols, rows.data());
+    kernel_row_sums(rows.data(), this->_rows, this->_cols, sum_vector.data());
     
     return sum_vector;
 }
@@ -613,26 +596,28 @@ template <typename T>
 inline DenseMatrix1D<T> DenseMatrix1D<T>::kron(const DenseMatrix1D<T>& matrix)
 {
     //Initializing and allocating the product matrix
-    int prod_size = this->_rows * matrix._rows;
-    DenseMatrix1D<T> prod_matrix(prod_size, prod_size);
+    DenseMatrix1D<T> prod_matrix(this->_rows * matrix._rows, this->_cols * matrix._cols);
     
     /*
      *  Calculating the kronecker product:
      *  The indices of the product matrix is calculated by:
      *      i = (i_outer*size) + i_inner
      *      j = (j_outer*size) + j_inner
+     *  every row of matrix is added, scaled, to a segment of a row of the (zero) product.
      */
     for (int i_outer = 0; i_outer < this->_rows; i_outer++)
     {
         for (int j_outer=0; j_outer < this->_cols; j_outer++)
         {
+            T value = this->_edges[(size_t) i_outer*this->_cols + j_outer];
+            if (value == 0)
+            {
+                continue;
+            }
             for(int i_inner=0; i_inner < matrix._rows; i_inner++)
             {
-                for(int j_inner=0; j_inner < matrix._cols; j_inner++)
-                {
-                    prod_matrix._edges[((i_outer*matrix._rows) + i_inner)* prod_matrix._cols + (j_outer*matrix._cols) + j_inner] 
-                        = matrix._edges[i_inner*matrix._cols+ j_inner] * this->_edges[i_outer*this->_cols + j_outer];
-                }
+                T* segment = prod_matrix._edges + ((size_t) i_outer*matrix._rows + i_inner) * prod_matrix._cols + (size_t) j_outer*matrix._cols;
+                kernel_axpy(value, matrix._edges + (size_t) i_inner*matrix._cols, segment, matrix._cols);
             }
         }
     }
@@ -651,13 +636,7 @@ inline DenseMatrix1D<T> DenseMatrix1D<T>::diagonalVectorTimesMatrix(const std::v
         throw DimensionMismatchException();
     }
     
-    DenseMatrix1D<T> ret_matrix(*this);
-    for(int i = 0; i < this->_getArrSize(); i++)
-    {
-        ret_matrix._edges[i] = vec[i/this->_rows] * this->_edges[i];
-    }
-    
-    return ret_matrix;
+    return DenseMatrix1D<T>(diagonal_scaling(&vec, lazy(*this), (const std::vector<T>*) NULL));
 }
 
 /*
@@ -672,16 +651,7 @@ inline DenseMatrix1D<T> DenseMatrix1D<T>::matrixTimesDiagonalVector(const std::v
         throw DimensionMismatchException();
     }
     
-    DenseMatrix1D<T> ret_matrix(*this);
-    for(int i = 0; i < this->_getArrSize(); )
-    {
-        for(int j = 0; j < vec.size(); j++)
-        {
-            ret_matrix._edges[i] = this->_edges[i] * vec[j];
-            i++;
-        }
-    }
-    return ret_matrix;
+    return DenseMatrix1D<T>(diagonal_scaling((const std::vector<T>*) NULL, lazy(*this), &vec));
 }
 
 //===========================================================MPI SEND/REC================================================================
@@ -751,14 +721,82 @@ inline T& DenseMatrix1D<T>::operator()(int i, int j)
 }
 
 /*
- * Overloaded = operator copies the content of another matrix to this
+ * Overloaded () operator that returns the value of an element of a const matrix
+ * @pram int i
+ * @pram int j
+ */
+template <typename T>
+inline const T& DenseMatrix1D<T>::operator()(int i, int j) const
+{
+    return this->_edges[(i * this->_cols) + j];
+}
+
+/*
+ * Overloaded = operator copies the content of another matrix to this, the storage is kept when the sizes match
  * @pram: DenseMatrix1D<T> 
  */
 template <typename T>
-inline void DenseMatrix1D<T>::operator=(const DenseMatrix1D<T>& matrix)
+inline DenseMatrix1D<T>& DenseMatrix1D<T>::operator=(const DenseMatrix1D<T>& matrix)
 {
-    delete [] this->_edges;
+    if (this == &matrix)
+    {
+        return *this;
+    }
+    if (this->_getArrSize() == matrix._getArrSize())
+    {
+        this->_rows = matrix._rows;
+        this->_cols = matrix._cols;
+        memcpy(this->_edges, matrix._edges, this->_getArrSize() * sizeof(T));
+        return *this;
+    }
+    MatrixPool::release(this->_edges, this->_getArrSize() * sizeof(T));
     _copy(matrix);
+    return *this;
+}
+
+/*
+ * Overloaded = operator takes the storage of another matrix, the other matrix gets the storage of this
+ * @pram: DenseMatrix1D<T> 
+ */
+template <typename T>
+inline DenseMatrix1D<T>& DenseMatrix1D<T>::operator=(DenseMatrix1D<T>&& matrix)
+{
+    std::swap(this->_rows, matrix._rows);
+    std::swap(this->_cols, matrix._cols);
+    std::swap(this->_edges, matrix._edges);
+    return *this;
+}
+
+/*
+ * Overloaded = operator evaluates an expression (DenseExpression.h) in one pass, the storage is kept when the sizes match.
+ * The expression can refer to this matrix.
+ * @pram: DenseExpression<E>
+ */
+template <typename T>
+template <typename E>
+inline DenseMatrix1D<T>& DenseMatrix1D<T>::operator=(const DenseExpression<E>& expression)
+{
+    const E& entries = expression.self();
+    int rows = entries.getNumberOfRows();
+    int cols = entries.getNumberOfColumns();
+    if ((size_t) rows * cols != this->_getArrSize())
+    {
+        MatrixPool::release(this->_edges, this->_getArrSize() * sizeof(T));
+        this->_rows = rows;
+        this->_cols = cols;
+        _initializeMatrix(false);
+    }
+    this->_rows = rows;
+    this->_cols = cols;
+    for (int i = 0; i < rows; i++)
+    {
+        T* row = this->_edges + (size_t) i * cols;
+        for (int j = 0; j < cols; j++)
+        {
+            row[j] = (T) entries(i, j);
+        }
+    }
+    return *this;
 }
 
 /*
@@ -792,12 +830,7 @@ inline bool DenseMatrix1D<T>::operator==(const DenseMatrix1D<T>& matrix)
 template <typename T>
 inline DenseMatrix1D<T> DenseMatrix1D<T>::operator+(const DenseMatrix1D<T>& other_matrix)
 {
-    DenseMatrix1D<T> ret_matrix(this->_rows,this->_cols);
-    for(int i = 0; i < this->_getArrSize() ;i++)
-    {   
-        ret_matrix._edges[i] = this->_edges[i] + other_matrix._edges[i];
-    }
-    return ret_matrix;
+    return DenseMatrix1D<T>(lazy(*this) + lazy(other_matrix));
 }
 
 /*
@@ -807,12 +840,7 @@ inline DenseMatrix1D<T> DenseMatrix1D<T>::operator+(const DenseMatrix1D<T>& othe
 template <typename T>
 inline DenseMatrix1D<T> DenseMatrix1D<T>::operator-(const DenseMatrix1D<T>& other_matrix)
 {
-    DenseMatrix1D<T> ret_matrix(this->_rows,this->_cols);
-    for(int i = 0; i < this->_getArrSize() ;i++)
-    {   
-        ret_matrix._edges[i] = this->_edges[i] - other_matrix._edges[i];
-    }
-    return ret_matrix;
+    return DenseMatrix1D<T>(lazy(*this) - lazy(other_matrix));
 }
 
 /*
@@ -822,20 +850,18 @@ inline DenseMatrix1D<T> DenseMatrix1D<T>::operator-(const DenseMatrix1D<T>& othe
 template <typename T>
 inline DenseMatrix1D<T> DenseMatrix1D<T>::operator*(const DenseMatrix1D<T>& other_matrix)
 {
-    DenseMatrix1D<T> ret_matrix(this->_rows,this->_cols);
-    T ret_val;
-    for(int i = 0; i < this->_rows;i++)
+    if (this->_cols != other_matrix._rows)
     {
-        for(int j = 0; j < other_matrix._cols;j++)
-        {
-            ret_val = 0;
-            for(int k = 0; k < this->_cols;k++)
-            {
-               ret_val += this->_edges[i*this->_cols + k] * other_matrix._edges[k*other_matrix._cols + j];
-            }
-            ret_matrix._edges[i * ret_matrix._cols + j] = ret_val;
-        }
+        throw DimensionMismatchException();
     }
+    DenseMatrix1D<T> ret_matrix(this->_rows,other_matrix._cols);
+    PooledArray<const T*> rows(this->_rows);
+    PooledArray<const T*> other_rows(other_matrix._rows);
+    PooledArray<T*> ret_rows(ret_matrix._rows);
+    row_pointers(this->_edges, this->_rows, this->_cols, rows.data());
+    row_pointers(other_matrix._edges, other_matrix._rows, other_matrix._cols, other_rows.data());
+    row_pointers(ret_matrix._edges, ret_matrix._rows, ret_matrix._cols, ret_rows.data());
+    kernel_gemm(rows.data(), other_rows.data(), ret_rows.data(), this->_rows, this->_cols, other_matrix._cols);
     return ret_matrix;
 }
 
@@ -875,7 +901,7 @@ inline void DenseMatrix1D<T>::_copy(const DenseMatrix1D<T>& matrix)
 }
 
 /*
- * makes a 1D array of size _rows*_cols
+ * makes a 1D array of size _rows*_cols (borrowed from the MatrixPool)
  * @pram: bool fill: if true: initialize values to 0.
  */  
 template <typename T>
@@ -883,13 +909,10 @@ inline void DenseMatrix1D<T>::_initializeMatrix(bool fill)
 {
     try
     {
+        this->_edges = (T*) MatrixPool::allocate(this->_getArrSize() * sizeof(T));
         if (fill)
         {
-            this->_edges = new T[this->_getArrSize()]();
-        }
-        else
-        {
-            this->_edges = new T[this->_getArrSize()];
+            std::fill(this->_edges, this->_edges + this->_getArrSize(), T());
         }
     }
     catch (std::bad_alloc& e)
@@ -1,7 +1,8 @@
 /*********************************************************************************
  * Dense Matrix Data Structure. This structure uses a two dimensional array that *
  * is dynamically allocated to hold all the values in a matrix.                  * 
- *                                                                               *
+ * The bulk operations (norm, row sums, transpose, product) use the kernels of   *
+ * MatrixKernels.h on the rows.                                                  *
  *********************************************************************************/
 
 #ifndef _DenseMatrix2D_h
@@ -16,18 +17,9 @@
 #include <fstream>
 #include "MatrixExceptions.h"
 #include "SparseElement.h"
-
-#ifdef EIGEN
-#include <Eigen/Dense>
-#include <Eigen/Sparse>
-#endif
-
-#ifdef ARPACK
-#include "dsmatrxa.h"
-#include "ardsmat.h"
-#include "ardssym.h"
-#include "lsymsol.h"
-#endif
+#include "GraphFile.h"
+#include "Lanczos.h"
+#include "MatrixKernels.h"
 
 #ifdef USE_MPI
 #include "mpi.h"
@@ -153,34 +145,21 @@ inline DenseMatrix2D<T>::DenseMatrix2D(bool fill)
 /*
  * DensMatrix constructor:
  * Construct a matrix by reading a matrix file, specified in readme.txt file the nodes that exist will have _DEFAULT_MATRIX_ENTRY value.
+ * The file is parsed by GraphFile, a malformed file throws MatrixReaderException.
  * @pram std::string : path to the file
  */
 template<typename T>
 inline DenseMatrix2D<T>::DenseMatrix2D(const std::string &file_path)
 {
-    int tmp_x;
-    int tmp_y;
-    std::ifstream file_reader;
-    file_reader.open(file_path.c_str());
-   
-    if(file_reader.fail())
-    {
-        file_reader.close();
-        throw FileDoesNotExistException(file_path);
-    }
-    
-    file_reader >> this->_rows;
-    file_reader >> this->_cols;
-    file_reader >> tmp_x;      //skip the number of lines entry
+    GraphFile graph_file(file_path);
+    this->_rows = graph_file.getNumberOfRows();
+    this->_cols = graph_file.getNumberOfColumns();
     _initializeMatrix(true);
   
-    while (!file_reader.eof())
+    for (int k = 0; k < graph_file.getNumberOfEntries(); k++)
     {
-        file_reader >> tmp_x;
-        file_reader >> tmp_y;
-        this->_edges[tmp_x - 1][tmp_y - 1] = _DEFAULT_MATRIX_ENTRY;
+        this->_edges[graph_file.getRow(k)][graph_file.getColumn(k)] = _DEFAULT_MATRIX_ENTRY;
     }
-    file_reader.close();
 }
 
 /*
@@ -407,10 +386,10 @@ inline bool DenseMatrix2D<T>::isSymmetric()
         return false;
     }
 
-    //checking for entries to be equal
+    //checking for entries to be equal, every pair is compared once
     for(int i=0; i < this->_rows; i++)
     {
-        for(int j=0; j<this->_cols;j++)
+        for(int j=i+1; j<this->_cols;j++)
         {
             if (this->_edges[i][j] != this->_edges[j][i])
             {
@@ -500,73 +479,40 @@ inline T DenseMatrix2D<T>::getFrobNorm()
 
     for(int i = 0; i < this->_rows; i++)
     {
-        for(int j = 0; j < this->_cols; j++)
-        {
-            ret_val+= this->_edges[i][j] * this->_edges[i][j];
-        }
+        ret_val += kernel_sum_of_squares(this->_edges[i], this->_cols);
     }
     return ret_val;
 }
 
 /*
- * Returns a std::vector<T> that contains the values of the eigenvector associated to the largest eigenvalue
+ * Returns an array (delete [] it after usage) that contains the values of the eigenvector associated to the largest eigenvalue,
+ * found with the Lanczos solver of Lanczos.h.
  */
 template <typename T>
 inline T* DenseMatrix2D<T>::getTopEigenVector()
 {
-#ifdef ARPACK
-    int arr_size = (this->_rows*(this->_rows+1))/2;
-    T nzval[arr_size];
-    int counter=0;
-    for(int i=0; i<this->_rows; i++)
+    //y = A x on the full matrix, the start vector of ones is not orthogonal to the Perron vector
+    auto apply = [this](const double* x, double* y)
     {
-        for(int j=i;j < this->_rows ;j++)
+        for (int i = 0; i < this->_rows; i++)
         {
-            nzval[counter++]= this->_edges[i][j];
+            double sum = 0;
+            for (int j = 0; j < this->_rows; j++)
+            {
+                sum += this->_edges[i][j] * x[j];
+            }
+            y[i] = sum;
         }
-    }
-    
-    ARdsSymMatrix<T> ARMatrix(this->_rows,nzval,'L');
-    ARluSymStdEig<T> eigProb(1, ARMatrix, "LM",10);
-    eigProb.FindEigenvectors();
+    };
+    std::vector<double> top(this->_rows, 1.0);
+    lanczos_top_eigen(apply, top);
+
     T* eigen_vector = new T[this->_rows];
-     
-    for (int i=0; i < this->_rows ; i++)
+    for (int i = 0; i < this->_rows; i++)
     {
-        eigen_vector[i] = eigProb.Eigenvector(0,i);
+        eigen_vector[i] = top[i];
     }
     return eigen_vector;
-#endif
-
-#ifdef EIGEN
-        Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> A_eigen = Eigen::MatrixXd::Zero(this->_rows, this->_cols);
-        for (int i=0; i< this->_rows; i++) 
-        {
-            for(int j = 0; j < this->_cols; j++)
-            {
-                A_eigen(i,j) = this->_edges[i][j];
-            }
-        }
-        Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es;
-        es.compute(A_eigen);
-        
-        Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> evals_eigen = es.eigenvalues();
-        Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> evecs_eigen = es.eigenvectors();
-        T* eigen_vector = new T[this->_rows];
-
-        for ( int i=0; i < this->_cols; i++)
-        {   
-            if (evals_eigen(i) == evals_eigen.maxCoeff())
-            {
-                for (int j= 0; j < this->_rows ; j++)
-                {
-                    eigen_vector[j] = evecs_eigen(j,i);
-                }
-                break;
-            }
-        }
-    return eigen_vector;
-#endif
 }
 
 /*
@@ -575,15 +521,9 @@ inline T* DenseMatrix2D<T>::getTopEigenVector()
 template <typename T>
 inline DenseMatrix2D<T> DenseMatrix2D<T>::transpose()
 {
-    DenseMatrix2D<T> ret_matrix(this->_rows,this->_cols, false);
+    DenseMatrix2D<T> ret_matrix(this->_cols,this->_rows, false);
 
-    for(int i=0;i<this->_rows;i++)
-    {
-        for(int j=0;j<this->_cols;j++)
-        {
-            ret_matrix._edges[j][i] = this->_edges[i][j];
-        }
-    }
+    kernel_transpose(this->_edges, ret_matrix._edges, this->_rows, this->_cols);
     return ret_matrix;
 }
 
@@ -594,13 +534,7 @@ template <typename T>
 inline std::vector<T> DenseMatrix2D<T>::getSumOfRows()
 {
     std::vector<T> sum_vec(this->_rows);
-    for(int i=0; i < _rows; i++)
-    {
-        for (int j = 0; j < _cols; j++)
-        {
-            sum_vec[i] += this->_edges[i][j];
-        }
-    }
+    kernel_row_sums(this->_edges, this->_rows, this->_cols, sum_vec.data());
     return sum_vec;
 }
 
@@ -878,20 +812,12 @@ inline DenseMatrix2D<T> DenseMatrix2D<T>::operator-(const DenseMatrix2D<T>& othe
 template <typename T>
 inline DenseMatrix2D<T> DenseMatrix2D<T>::operator*(const DenseMatrix2D<T>& other_matrix)
 {
-    DenseMatrix2D<T> ret_matrix(this->_rows,this->_cols, false);
-    T ret_val;
-    for(int i = 0; i < this->_rows;i++)
+    if (this->_cols != other_matrix._rows)
     {
-        for(int j = 0; j < other_matrix._cols;j++)
-        {
-            ret_val = 0;
-            for(int k = 0; k < this->_cols;k++)
-            {
-               ret_val += this->_edges[i][k] * other_matrix._edges[k][j];
-            }
-            ret_matrix._edges[i][j] = ret_val;
-        }
+        throw DimensionMismatchException();
     }
+    DenseMatrix2D<T> ret_matrix(this->_rows,other_matrix._cols);
+    kernel_gemm(this->_edges, other_matrix._edges, ret_matrix._edges, this->_rows, this->_cols, other_matrix._cols);
   
     return ret_matrix;
 }
@@ -0,0 +1,211 @@
+/*********************************************************************************
+ * Reader for the graph file format described in the README: a header line with  *
+ * "rows cols nnz" followed by nnz lines "row col" (1 based). The file is memory *
+ * mapped and the integers are scanned straight from the mapped bytes, the       *
+ * number of entries read is checked against the nnz of the header and every     *
+ * index is checked against the size of the matrix.                              *
+ *********************************************************************************/
+
+#ifndef _GraphFile_h
+#define _GraphFile_h
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <climits>
+#include <algorithm>
+#include "MatrixExceptions.h"
+#include "MappedFile.h"
+
+/*
+ * GraphFile class definition and method declarations.
+ */
+class GraphFile
+{
+private:
+    bool _nextInt(const char** position, const char* end, int* value) const;
+    void _throwError(const std::string& message, const char* position) const;
+
+protected:
+    std::string _file_path;
+    const char* _file_begin;
+    int _rows;
+    int _cols;
+    std::vector<int> _entry_rows;
+    std::vector<int> _entry_cols;
+
+public:
+    /**************
+     *Constructors*
+     **************/
+    explicit GraphFile(const std::string& file_path);
+
+    /***********
+     *ACCESSORS*
+     ***********/
+    int getNumberOfRows() const;
+    int getNumberOfColumns() const;
+    int getNumberOfEntries() const;
+    int getRow(int entry) const;
+    int getColumn(int entry) const;
+};
+
+//==========================================================CONSTRUCTORS============================================================
+/*
+ * GraphFile constructor:
+ * Reads and validates a graph file, throws FileDoesNotExistException if the file can not be opened
+ * and MatrixReaderException if the contents do not follow the format.
+ * @pram std::string : path to the file
+ */
+inline GraphFile::GraphFile(const std::string& file_path)
+{
+    MappedFile mapped_file(file_path);
+    const char* position = mapped_file.begin();
+    const char* end = mapped_file.end();
+    this->_file_path = file_path;
+    this->_file_begin = mapped_file.begin();
+
+    int nnz;
+    if (!this->_nextInt(&position, end, &this->_rows) || !this->_nextInt(&position, end, &this->_cols)
+        || !this->_nextInt(&position, end, &nnz))
+    {
+        this->_throwError("the header must be 'rows cols nnz'", position);
+    }
+
+    //every entry takes at least 4 bytes ("i j\n"), a broken header can not make us reserve more than that
+    this->_entry_rows.reserve(std::min((size_t) nnz, mapped_file.size() / 4 + 1));
+    this->_entry_cols.reserve(std::min((size_t) nnz, mapped_file.size() / 4 + 1));
+    int row, col;
+    while (this->_nextInt(&position, end, &row))
+    {
+        if (!this->_nextInt(&position, end, &col))
+        {
+            this->_throwError("an entry is missing its column", position);
+        }
+        if (row < 1 || row > this->_rows || col < 1 || col > this->_cols)
+        {
+            this->_throwError("an entry is outside of the matrix", position);
+        }
+        this->_entry_rows.push_back(row - 1);
+        this->_entry_cols.push_back(col - 1);
+    }
+
+    if (this->_entry_rows.size() != nnz)
+    {
+        std::ostringstream message;
+        message << "the header has " << nnz << " entries but " << this->_entry_rows.size() << " were read";
+        this->_throwError(message.str(), position);
+    }
+    this->_file_begin = NULL;
+}
+
+//===========================================================ACCESSORS===============================================================
+/*
+ * Returns the number of rows of the matrix in the file.
+ */
+inline int GraphFile::getNumberOfRows() const
+{
+    return this->_rows;
+}
+
+/*
+ * Returns the number of columns of the matrix in the file.
+ */
+inline int GraphFile::getNumberOfColumns() const
+{
+    return this->_cols;
+}
+
+/*
+ * Returns the number of entries read.
+ */
+inline int GraphFile::getNumberOfEntries() const
+{
+    return this->_entry_rows.size();
+}
+
+/*
+ * Returns the row of an entry (0 based).
+ * @pram int entry
+ */
+inline int GraphFile::getRow(int entry) const
+{
+    return this->_entry_rows[entry];
+}
+
+/*
+ * Returns the column of an entry (0 based).
+ * @pram int entry
+ */
+inline int GraphFile::getColumn(int entry) const
+{
+    return this->_entry_cols[entry];
+}
+
+//===========================================================PRIVATE=================================================================
+/*
+ * Scans the next non-negative integer, whitespace is skipped. Returns false at the end of the file,
+ * throws MatrixReaderException on any other character or on overflow.
+ * @pram: pointer to the current position, moved past the integer
+ * @pram: end of the file
+ * @pram: pointer to the value read
+ */
+inline bool GraphFile::_nextInt(const char** position, const char* end, int* value) const
+{
+    const char* p = *position;
+    while (p != end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r'))
+    {
+        p++;
+    }
+    if (p == end)
+    {
+        *position = p;
+        return false;
+    }
+    if (*p < '0' || *p > '9')
+    {
+        this->_throwError("unexpected character", p);
+    }
+
+    long number = 0;
+    while (p != end && *p >= '0' && *p <= '9')
+    {
+        number = number * 10 + (*p - '0');
+        if (number > INT_MAX)
+        {
+            this->_throwError("number is too large", p);
+        }
+        p++;
+    }
+    *position = p;
+    *value = (int) number;
+    return true;
+}
+
+/*
+ * Throws a MatrixReaderException with the file name and the line of the error.
+ * @pram: description of the error
+ * @pram: position in the file where the error was found
+ */
+inline void GraphFile::_throwError(const std::string& message, const char* position) const
+{
+    std::ostringstream full_message;
+    full_message << this->_file_path;
+    if (this->_file_begin != NULL)
+    {
+        int line = 1;
+        for (const char* p = this->_file_begin; p < position; p++)
+        {
+            if (*p == '\n')
+            {
+                line++;
+            }
+        }
+        full_message << ":" << line;
+    }
+    full_message << ": " << message;
+    throw MatrixReaderException(full_message.str());
+}
+
+//===================================================================================================================================
+#endif
@@ -0,0 +1,257 @@
+/*********************************************************************************
+ * Packed binary collection of graphs. A pack holds any number of graphs in CSR  *
+ * form in one file so a dataset is opened with a single mmap instead of parsing *
+ * one text file per graph. The graphs are views of the mapped file, startup     *
+ * costs a page fault per touched page rather than a parse of every entry.       *
+ *                                                                               *
+ * Layout (native byte order, every array starts on an 8 byte boundary):         *
+ *   GraphPackHeader    magic "ISOPACK1", version, number of graphs             *
+ *   GraphPackEntry[n]  offset of the graph in the file, nodes, nnz             *
+ *   per graph          int row_ptr[nodes + 1], int col_idx[nnz] (0 based)      *
+ *********************************************************************************/
+
+#ifndef _GraphPack_h
+#define _GraphPack_h
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstring>
+#include "MatrixExceptions.h"
+#include "MappedFile.h"
+#include "CSRGraph.h"
+
+static const char GRAPH_PACK_MAGIC[8] = {'I', 'S', 'O', 'P', 'A', 'C', 'K', '1'};
+static const int GRAPH_PACK_VERSION = 1;
+
+/*
+ * first bytes of a pack
+ */
+struct GraphPackHeader
+{
+    char magic[8];
+    int version;
+    int number_of_graphs;
+};
+
+/*
+ * position and size of one graph of a pack
+ */
+struct GraphPackEntry
+{
+    long long offset;
+    int nodes;
+    int edges;
+};
+
+/*
+ * GraphPack class definition and method declarations.
+ */
+class GraphPack
+{
+private:
+    static size_t _align(size_t offset);
+    void _throwError(const std::string& message) const;
+
+protected:
+    MappedFile _file;
+    const GraphPackEntry* _entries;
+    int _number_of_graphs;
+
+public:
+    /**************
+     *Constructors*
+     **************/
+    explicit GraphPack(const std::string& file_path);
+
+    /***********
+     *ACCESSORS*
+     ***********/
+    int getNumberOfGraphs() const;
+    int getNumberOfNodes(int graph) const;
+    int getNumberOfEdges(int graph) const;
+    CSRGraph getGraph(int graph) const;
+
+    /**********
+    *OPERATIONS*
+    **********/
+    static void write(const std::string& file_path, const std::vector<CSRGraph*>& graphs);
+};
+
+//==========================================================CONSTRUCTORS============================================================
+/*
+ * GraphPack constructor:
+ * Maps a pack and checks its header and offset table, the graphs themselves are not read.
+ * Throws FileDoesNotExistException if the file can not be opened and MatrixReaderException if it is not a valid pack.
+ * @pram std::string : path to the pack
+ */
+inline GraphPack::GraphPack(const std::string& file_path)
+    : _file(file_path)
+{
+    if (this->_file.size() < sizeof(GraphPackHeader))
+    {
+        this->_throwError("the file is too small to be a graph pack");
+    }
+    const GraphPackHeader* header = (const GraphPackHeader*) this->_file.begin();
+    if (std::memcmp(header->magic, GRAPH_PACK_MAGIC, sizeof(GRAPH_PACK_MAGIC)) != 0)
+    {
+        this->_throwError("the file is not a graph pack");
+    }
+    if (header->version != GRAPH_PACK_VERSION)
+    {
+        this->_throwError("unsupported graph pack version");
+    }
+    if (header->number_of_graphs < 0
+        || (this->_file.size() - sizeof(GraphPackHeader)) / sizeof(GraphPackEntry) < (size_t) header->number_of_graphs)
+    {
+        this->_throwError("the offset table is truncated");
+    }
+    this->_number_of_graphs = header->number_of_graphs;
+    this->_entries = (const GraphPackEntry*) (this->_file.begin() + sizeof(GraphPackHeader));
+
+    for (int g = 0; g < this->_number_of_graphs; g++)
+    {
+        const GraphPackEntry& entry = this->_entries[g];
+        size_t bytes = ((size_t) entry.nodes + 1 + entry.edges) * sizeof(int);
+        if (entry.nodes < 0 || entry.edges < 0 || entry.offset < 0 || entry.offset % sizeof(long long) != 0
+            || (size_t) entry.offset > this->_file.size() || this->_file.size() - entry.offset < bytes)
+        {
+            this->_throwError("graph " + std::to_string(g + 1) + " is outside of the file");
+        }
+    }
+}
+
+//===========================================================ACCESSORS===============================================================
+/*
+ * Returns the number of graphs in the pack.
+ */
+inline int GraphPack::getNumberOfGraphs() const
+{
+    return this->_number_of_graphs;
+}
+
+/*
+ * Returns the number of nodes of a graph without touching its arrays.
+ * @pram int graph: index of the graph (0 based)
+ */
+inline int GraphPack::getNumberOfNodes(int graph) const
+{
+    return this->_entries[graph].nodes;
+}
+
+/*
+ * Returns the number of non-zero entries of a graph without touching its arrays.
+ * @pram int graph: index of the graph (0 based)
+ */
+inline int GraphPack::getNumberOfEdges(int graph) const
+{
+    return this->_entries[graph].edges;
+}
+
+/*
+ * Returns a view of a graph, the view is valid as long as the pack exists.
+ * The arrays are checked before the view is made, O(nodes + nnz): the row offsets must go from 0 to nnz without
+ * decreasing and the neighbors of every node must be sorted nodes of the graph without repeats, otherwise
+ * MatrixReaderException is thrown.
+ * @pram int graph: index of the graph (0 based)
+ */
+inline CSRGraph GraphPack::getGraph(int graph) const
+{
+    const GraphPackEntry& entry = this->_entries[graph];
+    const int* row_ptr = (const int*) (this->_file.begin() + entry.offset);
+    const int* col_idx = row_ptr + entry.nodes + 1;
+    if (row_ptr[0] != 0 || row_ptr[entry.nodes] != entry.edges)
+    {
+        this->_throwError("graph " + std::to_string(graph + 1) + " has broken row offsets");
+    }
+    for (int i = 0; i < entry.nodes; i++)
+    {
+        if (row_ptr[i + 1] < row_ptr[i] || row_ptr[i + 1] > entry.edges)
+        {
+            this->_throwError("graph " + std::to_string(graph + 1) + " has broken row offsets at node "
+                              + std::to_string(i + 1));
+        }
+        for (int k = row_ptr[i]; k < row_ptr[i + 1]; k++)
+        {
+            if (col_idx[k] < 0 || col_idx[k] >= entry.nodes || (k > row_ptr[i] && col_idx[k] <= col_idx[k - 1]))
+            {
+                this->_throwError("graph " + std::to_string(graph + 1) + " has a broken neighbor list at node "
+                                  + std::to_string(i + 1));
+            }
+        }
+    }
+    return CSRGraph(entry.nodes, entry.edges, row_ptr, (entry.edges > 0) ? col_idx : NULL);
+}
+
+//===========================================================OPERATIONS================================================================
+/*
+ * Writes graphs to a pack, throws MatrixReaderException if the file can not be written.
+ * @pram std::string : path to the pack
+ * @pram std::vector<CSRGraph*> : the graphs, in the order they get in the pack
+ */
+inline void GraphPack::write(const std::string& file_path, const std::vector<CSRGraph*>& graphs)
+{
+    GraphPackHeader header;
+    std::memcpy(header.magic, GRAPH_PACK_MAGIC, sizeof(GRAPH_PACK_MAGIC));
+    header.version = GRAPH_PACK_VERSION;
+    header.number_of_graphs = graphs.size();
+
+    std::vector<GraphPackEntry> entries(graphs.size());
+    size_t offset = GraphPack::_align(sizeof(GraphPackHeader) + graphs.size() * sizeof(GraphPackEntry));
+    for (int g = 0; g < graphs.size(); g++)
+    {
+        entries[g].offset = offset;
+        entries[g].nodes = graphs[g]->getNumberOfNodes();
+        entries[g].edges = graphs[g]->getNumberOfEdges();
+        offset = GraphPack::_align(offset + ((size_t) entries[g].nodes + 1 + entries[g].edges) * sizeof(int));
+    }
+
+    std::ofstream pack_writer(file_path.c_str(), std::ios::binary | std::ios::trunc);
+    if (!pack_writer.is_open())
+    {
+        throw MatrixReaderException(file_path + ": could not open the graph pack for writing");
+    }
+    const char padding[sizeof(long long)] = {0};
+    pack_writer.write((const char*) &header, sizeof(header));
+    if (!entries.empty())
+    {
+        pack_writer.write((const char*) &entries[0], entries.size() * sizeof(GraphPackEntry));
+    }
+    size_t written = sizeof(GraphPackHeader) + graphs.size() * sizeof(GraphPackEntry);
+    for (int g = 0; g < graphs.size(); g++)
+    {
+        pack_writer.write(padding, entries[g].offset - written);
+        pack_writer.write((const char*) graphs[g]->getRowPointers(), (entries[g].nodes + 1) * sizeof(int));
+        if (entries[g].edges > 0)
+        {
+            pack_writer.write((const char*) graphs[g]->getColumnIndices(), entries[g].edges * sizeof(int));
+        }
+        written = entries[g].offset + ((size_t) entries[g].nodes + 1 + entries[g].edges) * sizeof(int);
+    }
+    if (!pack_writer)
+    {
+        throw MatrixReaderException(file_path + ": could not write the graph pack");
+    }
+}
+
+//===========================================================PRIVATE=================================================================
+/*
+ * Rounds an offset up to the next multiple of 8 bytes.
+ * @pram size_t offset
+ */
+inline size_t GraphPack::_align(size_t offset)
+{
+    return (offset + sizeof(long long) - 1) / sizeof(long long) * sizeof(long long);
+}
+
+/*
+ * Throws a MatrixReaderException with the path of the pack.
+ * @pram: description of the error
+ */
+inline void GraphPack::_throwError(const std::string& message) const
+{
+    throw MatrixReaderException(this->_file.getFilePath() + ": " + message);
+}
+
+//===================================================================================================================================
+#endif
@@ -0,0 +1,361 @@
+/*********************************************************************************
+ * Lanczos solver for the top (largest) eigenpair of a symmetric operator. The   *
+ * operator is only applied to vectors so it can be sparse or implicit (e.g. the *
+ * normalized adjacency matrix of a graph component), no external library is     *
+ * needed and the memory used is basis_size vectors. The Krylov basis is fully   *
+ * reorthogonalized and the iteration is restarted from the current Ritz vector  *
+ * when the basis is full. The small tridiagonal problem is solved with Sturm    *
+ * bisection for the eigenvalue and inverse iteration for the eigenvector. The   *
+ * vectors can be float (the dot products are still added in double), the mixed  *
+ * precision solver runs most iterations that way and refines the result with a  *
+ * few iterations in double.                                                     *
+ *********************************************************************************/
+
+#ifndef _Lanczos_h
+#define _Lanczos_h
+
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+static const int LANCZOS_BASIS_SIZE = 30;
+static const int LANCZOS_MAX_IT = 5000;
+static const double LANCZOS_TOL = 1e-10;
+//tolerance and maximum number of the float iterations of the mixed precision solver, float vectors can stall
+//a little above the tolerance, the cap keeps them from running to LANCZOS_MAX_IT when they do
+static const double LANCZOS_MIXED_TOL = 1e-6;
+static const int LANCZOS_MIXED_MAX_IT = 500;
+
+/*
+ * returns the number of eigenvalues of the symmetric tridiagonal matrix (alpha, beta) that are smaller than x
+ * @pram: diagonal
+ * @pram: off diagonal
+ * @pram: size of the matrix
+ * @pram: x
+ */
+inline int tridiagonal_sturm_count(const std::vector<double>& alpha, const std::vector<double>& beta, int size, double x)
+{
+    int count = 0;
+    double q = 1;
+    for (int i = 0; i < size; i++)
+    {
+        q = (alpha[i] - x) - ((i > 0) ? beta[i-1] * beta[i-1] / q : 0);
+        if (q == 0)
+        {
+            q = -std::numeric_limits<double>::min();
+        }
+        if (q < 0)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+/*
+ * returns the largest eigenvalue of a symmetric tridiagonal matrix (bisection on the Sturm count)
+ * @pram: diagonal
+ * @pram: off diagonal
+ * @pram: size of the matrix
+ */
+inline double tridiagonal_top_eigenvalue(const std::vector<double>& alpha, const std::vector<double>& beta, int size)
+{
+    //Gershgorin bounds
+    double lower = alpha[0];
+    double upper = alpha[0];
+    for (int i = 0; i < size; i++)
+    {
+        double radius = ((i > 0) ? fabs(beta[i-1]) : 0) + ((i < size - 1) ? fabs(beta[i]) : 0);
+        lower = std::min(lower, alpha[i] - radius);
+        upper = std::max(upper, alpha[i] + radius);
+    }
+
+    double scale = std::max(fabs(lower), fabs(upper));
+    while (upper - lower > 2 * std::numeric_limits<double>::epsilon() * scale + std::numeric_limits<double>::min())
+    {
+        double middle = 0.5 * (lower + upper);
+        if (middle <= lower || middle >= upper)
+        {
+            break;
+        }
+        if (tridiagonal_sturm_count(alpha, beta, size, middle) == size)
+        {
+            upper = middle;
+        }
+        else
+        {
+            lower = middle;
+        }
+    }
+    return 0.5 * (lower + upper);
+}
+
+/*
+ * computes the normalized eigenvector of a symmetric tridiagonal matrix for an eigenvalue with inverse iteration,
+ * (T - theta I) is factored once with partial pivoting and the solve is repeated on the normalized result.
+ * @pram: diagonal
+ * @pram: off diagonal
+ * @pram: size of the matrix
+ * @pram: the eigenvalue
+ * @pram: the eigenvector that gets filled (size entries)
+ */
+inline void tridiagonal_eigenvector(const std::vector<double>& alpha, const std::vector<double>& beta, int size,
+                                    double theta, std::vector<double>& s)
+{
+    double norm = 0;
+    for (int i = 0; i < size; i++)
+    {
+        norm = std::max(norm, fabs(alpha[i]) + ((i < size - 1) ? fabs(beta[i]) : 0));
+    }
+    double tiny = std::max(norm, 1.0) * std::numeric_limits<double>::epsilon();
+
+    //LU of T - theta I with partial pivoting, U has two super diagonals
+    std::vector<double> d(size), du(size, 0), du2(size, 0), dl(size, 0);
+    std::vector<char> swapped(size, 0);
+    for (int i = 0; i < size; i++)
+    {
+        d[i] = alpha[i] - theta;
+        if (i < size - 1)
+        {
+            du[i] = beta[i];
+            dl[i] = beta[i];
+        }
+    }
+    for (int i = 0; i < size - 1; i++)
+    {
+        if (fabs(d[i]) >= fabs(dl[i]))
+        {
+            if (d[i] == 0)
+            {
+                d[i] = tiny;
+            }
+            double factor = dl[i] / d[i];
+            dl[i] = factor;
+            d[i+1] -= factor * du[i];
+        }
+        else
+        {
+            double factor = d[i] / dl[i];
+            d[i] = dl[i];
+            dl[i] = factor;
+            double temp = du[i];
+            du[i] = d[i+1];
+            d[i+1] = temp - factor * d[i+1];
+            if (i < size - 2)
+            {
+                du2[i] = du[i+1];
+                du[i+1] = -factor * du[i+1];
+            }
+            swapped[i] = 1;
+        }
+    }
+    if (d[size-1] == 0)
+    {
+        d[size-1] = tiny;
+    }
+
+    s.assign(size, 1.0);
+    for (int it = 0; it < 3; it++)
+    {
+        for (int i = 0; i < size - 1; i++)
+        {
+            if (swapped[i])
+            {
+                double temp = s[i];
+                s[i] = s[i+1];
+                s[i+1] = temp - dl[i] * s[i];
+            }
+            else
+            {
+                s[i+1] -= dl[i] * s[i];
+            }
+        }
+        for (int i = size - 1; i >= 0; i--)
+        {
+            double sum = s[i];
+            if (i < size - 1)
+            {
+                sum -= du[i] * s[i+1];
+            }
+            if (i < size - 2)
+            {
+                sum -= du2[i] * s[i+2];
+            }
+            s[i] = sum / d[i];
+        }
+
+        double length = 0;
+        for (int i = 0; i < size; i++)
+        {
+            length += s[i] * s[i];
+        }
+        length = sqrt(length);
+        for (int i = 0; i < size; i++)
+        {
+            s[i] /= length;
+        }
+    }
+}
+
+/*
+ * finds the largest eigenvalue of a symmetric operator and its eigenvector with the Lanczos method.
+ * Returns the eigenvalue, x is overwritten with the normalized eigenvector.
+ * The eigenvector is only found in the span of the operator applied to the start vector, e.g. starting
+ * inside an invariant subspace (a connected component) gives the top eigenpair of that subspace.
+ * S is the type of the vectors (double or float), the tridiagonal problem is always solved in double.
+ * @pram: functor apply(const S* x, S* y) computing y = Op x (size entries each)
+ * @pram: warm start vector, must not be 0 (its size is the size of the operator)
+ * @pram: convergence tolerance on the residual |Op x - theta x| relative to max(1, |theta|)
+ * @pram: maximum number of applications of the operator
+ * @pram: number of basis vectors kept before a restart
+ * @pram: if not NULL, the number of applications of the operator is added to it
+ */
+template <typename Operator, typename S>
+double lanczos_top_eigen(Operator& apply, std::vector<S>& x, double tolerance = LANCZOS_TOL,
+                         int max_iterations = LANCZOS_MAX_IT, int basis_size = LANCZOS_BASIS_SIZE,
+                         int* applications = NULL)
+{
+    int size = x.size();
+    basis_size = std::max(2, std::min(basis_size, size));
+    std::vector<S> basis((size_t) basis_size * size);
+    std::vector<double> alpha(basis_size), beta(basis_size);
+    std::vector<S> w(size);
+    std::vector<double> s;
+    double theta = 0;
+
+    double length = 0;
+    for (int i = 0; i < size; i++)
+    {
+        length += (double) x[i] * x[i];
+    }
+    length = sqrt(length);
+    if (length == 0)
+    {
+        return 0;
+    }
+    for (int i = 0; i < size; i++)
+    {
+        x[i] /= length;
+    }
+
+    int iterations = 0;
+    bool converged = false;
+    while (!converged && iterations < max_iterations)
+    {
+        std::copy(x.begin(), x.end(), basis.begin());
+        int steps = 0;
+        for (int j = 0; j < basis_size && iterations < max_iterations; j++)
+        {
+            const S* v = &basis[(size_t) j * size];
+            apply(v, &w[0]);
+            iterations++;
+            steps = j + 1;
+
+            double a = 0;
+            for (int i = 0; i < size; i++)
+            {
+                a += (double) v[i] * w[i];
+            }
+            alpha[j] = a;
+
+            //full reorthogonalization against the basis (twice is enough)
+            for (int pass = 0; pass < 2; pass++)
+            {
+                for (int l = 0; l <= j; l++)
+                {
+                    const S* u = &basis[(size_t) l * size];
+                    double dot = 0;
+                    for (int i = 0; i < size; i++)
+                    {
+                        dot += (double) u[i] * w[i];
+                    }
+                    for (int i = 0; i < size; i++)
+                    {
+                        w[i] -= dot * u[i];
+                    }
+                }
+            }
+            double b = 0;
+            for (int i = 0; i < size; i++)
+            {
+                b += (double) w[i] * w[i];
+            }
+            b = sqrt(b);
+            beta[j] = b;
+
+            theta = tridiagonal_top_eigenvalue(alpha, beta, steps);
+            tridiagonal_eigenvector(alpha, beta, steps, theta, s);
+            double residual = b * fabs(s[j]);
+            if (residual <= tolerance * std::max(1.0, fabs(theta)) || b <= std::numeric_limits<double>::epsilon() * std::max(1.0, fabs(theta)))
+            {
+                converged = true;
+                break;
+            }
+            if (j + 1 < basis_size)
+            {
+                S* next = &basis[(size_t) (j + 1) * size];
+                for (int i = 0; i < size; i++)
+                {
+                    next[i] = w[i] / b;
+                }
+            }
+        }
+
+        //restart (or finish) with the Ritz vector
+        std::fill(x.begin(), x.end(), 0.0);
+        for (int l = 0; l < steps; l++)
+        {
+            const S* u = &basis[(size_t) l * size];
+            for (int i = 0; i < size; i++)
+            {
+                x[i] += s[l] * u[i];
+            }
+        }
+        length = 0;
+        for (int i = 0; i < size; i++)
+        {
+            length += (double) x[i] * x[i];
+        }
+        length = sqrt(length);
+        for (int i = 0; i < size; i++)
+        {
+            x[i] /= length;
+        }
+    }
+    if (applications != NULL)
+    {
+        *applications += iterations;
+    }
+    return theta;
+}
+
+/*
+ * mixed precision version of lanczos_top_eigen: the iterations run on float vectors (half the memory traffic of
+ * double) until the residual reaches LANCZOS_MIXED_TOL, then the result is refined by the double solver started
+ * from it, which needs fewer iterations than a cold start. The result has the accuracy of the double solver.
+ * @pram: functor apply(const float* x, float* y) computing y = Op x in float
+ * @pram: functor apply(const double* x, double* y) computing y = Op x in double
+ * @pram: warm start vector, must not be 0 (its size is the size of the operator)
+ * @pram: convergence tolerance of the refinement (see lanczos_top_eigen)
+ * @pram: maximum number of applications of each operator
+ * @pram: number of basis vectors kept before a restart
+ * @pram: if not NULL, the number of applications of the float operator is added to it
+ * @pram: if not NULL, the number of applications of the double operator is added to it
+ */
+template <typename LowOperator, typename Operator>
+double lanczos_top_eigen_mixed(LowOperator& apply_low, Operator& apply, std::vector<double>& x, double tolerance = LANCZOS_TOL,
+                               int max_iterations = LANCZOS_MAX_IT, int basis_size = LANCZOS_BASIS_SIZE,
+                               int* low_applications = NULL, int* applications = NULL)
+{
+    std::vector<float> x_low(x.begin(), x.end());
+    lanczos_top_eigen(apply_low, x_low, std::max(tolerance, LANCZOS_MIXED_TOL), std::min(max_iterations, LANCZOS_MIXED_MAX_IT),
+                      basis_size, low_applications);
+    for (int i = 0; i < x.size(); i++)
+    {
+        x[i] = x_low[i];
+    }
+    return lanczos_top_eigen(apply, x, tolerance, max_iterations, basis_size, applications);
+}
+
+#endif
@@ -14,11 +14,14 @@ struct IsoRank_Result
     int frob_norm;
     int assignment_length;
     int* assignments;
+    double runtime; //wall clock time of the comparison in ms
+    int restarts; //restarts of the matching algorithm that were run (over all the components)
 };
 
 
 #ifdef USE_MPI
 #include "mpi.h"
+#include <algorithm>
 
 
 static const unsigned short _DENSE_FORM = 0;
@@ -45,24 +48,43 @@ struct MPI_MatrixInfo
 };
 
 /*
- * Structure to send the offsets to nodes
+ * Structure to send a chunk of pairs of graphs to a worker node. The pairs (i,j) with i<j are numbered
+ * in row major order and a chunk is a range of positions in the order the pairs are handed out in.
+ * Chunks are guided: every chunk is a share of the pairs that are left, so the first chunks are large
+ * (few messages) and the last ones are small (no worker is left with a long tail).
+ * A chunk with count 0 tells the worker that there is no work left.
  */
-struct Offset
+static const int PAIR_CHUNK_FACTOR = 2;
+static const int PAIR_CHUNK_MIN = 1;
+
+struct PairChunk
 {
-    int i_start;
-    int i_end;
-    int j_start;
-    int j_end;
-    void setValues(int ID, int num_procs, int number_of_graphs)
+    int start;
+    int count;
+    void setValues(int next_pair, int number_of_comparisons, int number_of_workers)
+    {
+        int remaining = number_of_comparisons - next_pair;
+        start = next_pair;
+        count = remaining / (PAIR_CHUNK_FACTOR * std::max(number_of_workers, 1));
+        count = std::min(std::max(count, PAIR_CHUNK_MIN), remaining);
+    }
+    
+    /*
+     * finds the graphs (i,j) of the pair with the given number
+     * @pram: number of the pair
+     * @pram: number of graphs
+     * @pram: pointer to the first graph of the pair
+     * @pram: pointer to the second graph of the pair
+     */
+    static void pairFromIndex(int pair, int number_of_graphs, int* i, int* j)
     {
-        int number_of_comparisons = number_of_graphs*(number_of_graphs-1)/2;
-        int block_size = std::ceil((float)number_of_comparisons/(float)(num_procs-1));
-        int block_start = (ID - 1) * block_size + 1;
-        int block_end = std::min(ID*block_size, number_of_comparisons);
-        i_start = std::floor(((2*number_of_graphs-1) - std::sqrt(9-4*number_of_graphs*(1-number_of_graphs)-8*block_start))/2);
-        i_end = std::floor(((2*number_of_graphs-1) - std::sqrt(9-4*number_of_graphs*(1-number_of_graphs)-8*block_end))/2);
-        j_start = block_start + (i_start*(i_start+3-2*number_of_graphs))/2;
-        j_end = block_end + (i_end*(i_end+3-2*number_of_graphs))/2;
+        *i = 0;
+        while (pair >= number_of_graphs - 1 - *i)
+        {
+            pair -= number_of_graphs - 1 - *i;
+            (*i)++;
+        }
+        *j = *i + 1 + pair;
     }
 };
 
@@ -77,6 +99,8 @@ void MPI_Send_IsoRank_Result (IsoRank_Result result, int dest, int tag)
     MPI_Send(&result.assignment_length, 1, MPI_INT, dest, tag + 1, MPI_COMM_WORLD);
     MPI_Send(result.assignments, result.assignment_length, MPI_INT, dest, tag + 2, MPI_COMM_WORLD);
     MPI_Send(&result.frob_norm, 1, MPI_INT, dest, tag + 3, MPI_COMM_WORLD);
+    MPI_Send(&result.runtime, 1, MPI_DOUBLE, dest, tag + 4, MPI_COMM_WORLD);
+    MPI_Send(&result.restarts, 1, MPI_INT, dest, tag + 5, MPI_COMM_WORLD);
 }
 
 /*
@@ -92,6 +116,8 @@ struct IsoRank_Result MPI_Recv_IsoRank_Result(int source, int tag, MPI_Status& s
     result.assignments = new int[result.assignment_length];
     MPI_Recv(result.assignments ,result.assignment_length , MPI_INT, source, tag + 2, MPI_COMM_WORLD, &stat);
     MPI_Recv(&result.frob_norm, 1, MPI_INT, source, tag + 3, MPI_COMM_WORLD, &stat);
+    MPI_Recv(&result.runtime, 1, MPI_DOUBLE, source, tag + 4, MPI_COMM_WORLD, &stat);
+    MPI_Recv(&result.restarts, 1, MPI_INT, source, tag + 5, MPI_COMM_WORLD, &stat);
     return result;
 }
 
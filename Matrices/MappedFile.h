@@ -0,0 +1,164 @@
+/*********************************************************************************
+ * Read only memory mapped file. The file is mapped into memory when the object  *
+ * is constructed and unmapped when it is destroyed, the contents are read       *
+ * straight from the page cache without copying them into a stream buffer.       *
+ * Small files are read with a single read() call instead, mapping them costs    *
+ * more system calls than copying them.                                          *
+ *                                                                               *
+ *********************************************************************************/
+
+#ifndef _MappedFile_h
+#define _MappedFile_h
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "MatrixExceptions.h"
+
+static const size_t MAPPED_FILE_MIN_SIZE = 1 << 16;
+
+/*
+ * MappedFile class definition and method declarations.
+ */
+class MappedFile
+{
+private:
+    MappedFile(const MappedFile&);
+    void operator=(const MappedFile&);
+
+protected:
+    std::string _file_path;
+    const char* _data;
+    size_t _size;
+    bool _mapped;
+    std::vector<char> _buffer;
+
+public:
+    /**************
+     *Constructors*
+     **************/
+    explicit MappedFile(const std::string& file_path);
+
+    /************
+     *Destructor*
+     ************/
+    virtual ~MappedFile();
+
+    /***********
+     *ACCESSORS*
+     ***********/
+    const char* begin() const;
+    const char* end() const;
+    size_t size() const;
+    const std::string& getFilePath() const;
+};
+
+//==========================================================CONSTRUCTORS============================================================
+/*
+ * MappedFile constructor:
+ * Maps a whole file into memory (small files are copied), throws FileDoesNotExistException if the file can not be opened.
+ * @pram std::string : path to the file
+ */
+inline MappedFile::MappedFile(const std::string& file_path)
+{
+    this->_file_path = file_path;
+    this->_data = NULL;
+    this->_size = 0;
+    this->_mapped = false;
+
+    int file_descriptor = open(file_path.c_str(), O_RDONLY);
+    if (file_descriptor < 0)
+    {
+        throw FileDoesNotExistException(file_path);
+    }
+
+    struct stat file_stat;
+    if (fstat(file_descriptor, &file_stat) != 0)
+    {
+        close(file_descriptor);
+        throw MatrixReaderException(file_path + ": could not read the size of the file");
+    }
+    this->_size = file_stat.st_size;
+
+    if (this->_size > 0 && this->_size < MAPPED_FILE_MIN_SIZE)
+    {
+        this->_buffer.resize(this->_size);
+        size_t bytes_read = 0;
+        while (bytes_read < this->_size)
+        {
+            ssize_t count = read(file_descriptor, &this->_buffer[bytes_read], this->_size - bytes_read);
+            if (count <= 0)
+            {
+                close(file_descriptor);
+                throw MatrixReaderException(file_path + ": could not read the file");
+            }
+            bytes_read += count;
+        }
+        this->_data = &this->_buffer[0];
+    }
+    else if (this->_size > 0)
+    {
+        void* data = mmap(NULL, this->_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+        if (data == MAP_FAILED)
+        {
+            close(file_descriptor);
+            throw MatrixReaderException(file_path + ": could not map the file into memory");
+        }
+        madvise(data, this->_size, MADV_SEQUENTIAL);
+        this->_data = (const char*) data;
+        this->_mapped = true;
+    }
+    close(file_descriptor);
+}
+
+//==========================================================DESTRUCTOR==============================================================
+/*
+ * MappedFile destructor, unmaps the file.
+ */
+inline MappedFile::~MappedFile()
+{
+    if (this->_mapped)
+    {
+        munmap((void*) this->_data, this->_size);
+    }
+}
+
+//===========================================================ACCESSORS===============================================================
+/*
+ * Returns a pointer to the first byte of the file (NULL for an empty file).
+ */
+inline const char* MappedFile::begin() const
+{
+    return this->_data;
+}
+
+/*
+ * Returns a pointer past the last byte of the file.
+ */
+inline const char* MappedFile::end() const
+{
+    return this->_data + this->_size;
+}
+
+/*
+ * Returns the size of the file in bytes.
+ */
+inline size_t MappedFile::size() const
+{
+    return this->_size;
+}
+
+/*
+ * Returns the path of the file.
+ */
+inline const std::string& MappedFile::getFilePath() const
+{
+    return this->_file_path;
+}
+
+//===================================================================================================================================
+#endif
@@ -9,6 +9,7 @@
 #include <iostream>
 #include <stdexcept>
 #include <cstring>
+#include <string>
 
 class MatrixException : public std::exception{};
 class OutOfMemoryException : public MatrixException {};
@@ -20,20 +21,38 @@ class NotASymmetricMatrixException : public MatrixException {};
 class NotASquareMatrixException : public MatrixException {};
 
 
-class MatrixReaderException : public MatrixException {};
+class MatrixReaderException : public MatrixException
+{
+protected:
+    std::string _message;
+public:
+    explicit MatrixReaderException(std::string message = "Matrix file could not be read")
+    {
+    	_message = message;
+    }
+
+    virtual ~MatrixReaderException() throw() {}
+
+    virtual const char* what() const throw()
+    {
+    	return this->_message.c_str();
+    }
+};
 class FileDoesNotExistException : public std::exception
 {
 protected:
-    const char* _file_name;
+    std::string _file_name;
 public:
     explicit FileDoesNotExistException(std::string file_name)
     {
-    	_file_name = file_name.c_str();
+    	_file_name = file_name;
     }
 
+    virtual ~FileDoesNotExistException() throw() {}
+
     virtual const char* what() const throw()
     { 
-    	return this->_file_name;
+    	return this->_file_name.c_str();
     }
 };
 
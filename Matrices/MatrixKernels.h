@@ -0,0 +1,777 @@
+/*********************************************************************************
+ * Kernels used by the matrix classes for their bulk operations: the fused sum of*
+ * squares of the frobenius norm, row sums, y += alpha x, a cache blocked        *
+ * transpose and a cache blocked matrix product, and the popcounts of the AND and*
+ * XOR of two bitsets used by BitsetGraph. The float and double kernels have AVX2*
+ * (with FMA) and AVX-512 versions next to the scalar ones, the bitset kernels   *
+ * have POPCNT and AVX-512 VPOPCNTDQ versions; the best version the CPU supports *
+ * is picked once with CPUID the first time a kernel is used, so the binary stays*
+ * portable and does not need -mavx2. Other types and non x86 builds (or         *
+ * -DMATRIX_KERNELS_SCALAR) always use the scalar versions. The vector kernels   *
+ * add in a different order than the scalar loops so the results can differ in   *
+ * the last bits.                                                                *
+ *********************************************************************************/
+
+#ifndef _MatrixKernels_h
+#define _MatrixKernels_h
+
+#include <cstddef>
+#include <algorithm>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__)) && !defined(MATRIX_KERNELS_SCALAR)
+#define MATRIX_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+static const int MATRIX_KERNEL_SCALAR = 0;
+static const int MATRIX_KERNEL_AVX2 = 1;
+static const int MATRIX_KERNEL_AVX512 = 2;
+
+//tile of the blocked transpose and blocks of the matrix product (rows of A, rows of B, columns of B)
+static const int MATRIX_TRANSPOSE_TILE = 32;
+static const int MATRIX_GEMM_BLOCK_ROWS = 64;
+static const int MATRIX_GEMM_BLOCK_INNER = 128;
+static const int MATRIX_GEMM_BLOCK_COLS = 512;
+
+/*
+ * the kernels of one type that depend on the instruction set
+ */
+template <typename T>
+struct MatrixKernelTable
+{
+    T (*sum)(const T* x, size_t n);
+    T (*sum_of_squares)(const T* x, size_t n);
+    void (*axpy)(T alpha, const T* x, T* y, size_t n);
+};
+
+/*
+ * the bitset kernels, they depend on the popcount instructions of the CPU
+ */
+struct BitKernelTable
+{
+    size_t (*and_popcount)(const unsigned long long* a, const unsigned long long* b, size_t words);
+    size_t (*xor_popcount)(const unsigned long long* a, const unsigned long long* b, size_t words);
+};
+
+//==========================================================SCALAR==================================================================
+/*
+ * returns the sum of an array
+ * @pram: the array
+ * @pram: number of elements
+ */
+template <typename T>
+T scalar_sum(const T* x, size_t n)
+{
+    T ret_val = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        ret_val += x[i];
+    }
+    return ret_val;
+}
+
+/*
+ * returns the sum of the squares of an array
+ * @pram: the array
+ * @pram: number of elements
+ */
+template <typename T>
+T scalar_sum_of_squares(const T* x, size_t n)
+{
+    T ret_val = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        ret_val += x[i] * x[i];
+    }
+    return ret_val;
+}
+
+/*
+ * y += alpha * x
+ * @pram: alpha
+ * @pram: x
+ * @pram: y
+ * @pram: number of elements
+ */
+template <typename T>
+void scalar_axpy(T alpha, const T* x, T* y, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        y[i] += alpha * x[i];
+    }
+}
+
+/*
+ * returns the number of bits set in a word
+ * @pram: the word
+ */
+inline size_t scalar_popcount(unsigned long long x)
+{
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (size_t) ((x * 0x0101010101010101ULL) >> 56);
+}
+
+/*
+ * returns the number of bits set in a AND b
+ * @pram: bitset a
+ * @pram: bitset b
+ * @pram: number of 64 bit words
+ */
+inline size_t scalar_and_popcount(const unsigned long long* a, const unsigned long long* b, size_t words)
+{
+    size_t ret_val = 0;
+    for (size_t i = 0; i < words; i++)
+    {
+        ret_val += scalar_popcount(a[i] & b[i]);
+    }
+    return ret_val;
+}
+
+/*
+ * returns the number of bits set in a XOR b
+ * @pram: bitset a
+ * @pram: bitset b
+ * @pram: number of 64 bit words
+ */
+inline size_t scalar_xor_popcount(const unsigned long long* a, const unsigned long long* b, size_t words)
+{
+    size_t ret_val = 0;
+    for (size_t i = 0; i < words; i++)
+    {
+        ret_val += scalar_popcount(a[i] ^ b[i]);
+    }
+    return ret_val;
+}
+
+#ifdef MATRIX_KERNELS_X86
+//==========================================================POPCNT==================================================================
+//the bitset kernels of the avx2 level, every CPU with AVX2 has POPCNT
+__attribute__((target("popcnt"))) inline size_t popcnt_and_popcount(const unsigned long long* a, const unsigned long long* b, size_t words)
+{
+    size_t ret_val = 0;
+    for (size_t i = 0; i < words; i++)
+    {
+        ret_val += __builtin_popcountll(a[i] & b[i]);
+    }
+    return ret_val;
+}
+
+__attribute__((target("popcnt"))) inline size_t popcnt_xor_popcount(const unsigned long long* a, const unsigned long long* b, size_t words)
+{
+    size_t ret_val = 0;
+    for (size_t i = 0; i < words; i++)
+    {
+        ret_val += __builtin_popcountll(a[i] ^ b[i]);
+    }
+    return ret_val;
+}
+
+//==========================================================AVX2====================================================================
+__attribute__((target("avx2,fma"))) inline float avx2_reduce(__m256 v)
+{
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+    return _mm_cvtss_f32(sum);
+}
+
+__attribute__((target("avx2,fma"))) inline double avx2_reduce(__m256d v)
+{
+    __m128d sum = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    sum = _mm_add_sd(sum, _mm_unpackhi_pd(sum, sum));
+    return _mm_cvtsd_f64(sum);
+}
+
+__attribute__((target("avx2,fma"))) inline float avx2_sum(const float* x, size_t n)
+{
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        acc0 = _mm256_add_ps(acc0, _mm256_loadu_ps(x + i));
+        acc1 = _mm256_add_ps(acc1, _mm256_loadu_ps(x + i + 8));
+    }
+    float ret_val = avx2_reduce(_mm256_add_ps(acc0, acc1));
+    for (; i < n; i++)
+    {
+        ret_val += x[i];
+    }
+    return ret_val;
+}
+
+__attribute__((target("avx2,fma"))) inline double avx2_sum(const double* x, size_t n)
+{
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(x + i));
+        acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(x + i + 4));
+    }
+    double ret_val = avx2_reduce(_mm256_add_pd(acc0, acc1));
+    for (; i < n; i++)
+    {
+        ret_val += x[i];
+    }
+    return ret_val;
+}
+
+__attribute__((target("avx2,fma"))) inline float avx2_sum_of_squares(const float* x, size_t n)
+{
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m256 a = _mm256_loadu_ps(x + i);
+        __m256 b = _mm256_loadu_ps(x + i + 8);
+        acc0 = _mm256_fmadd_ps(a, a, acc0);
+        acc1 = _mm256_fmadd_ps(b, b, acc1);
+    }
+    float ret_val = avx2_reduce(_mm256_add_ps(acc0, acc1));
+    for (; i < n; i++)
+    {
+        ret_val += x[i] * x[i];
+    }
+    return ret_val;
+}
+
+__attribute__((target("avx2,fma"))) inline double avx2_sum_of_squares(const double* x, size_t n)
+{
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256d a = _mm256_loadu_pd(x + i);
+        __m256d b = _mm256_loadu_pd(x + i + 4);
+        acc0 = _mm256_fmadd_pd(a, a, acc0);
+        acc1 = _mm256_fmadd_pd(b, b, acc1);
+    }
+    double ret_val = avx2_reduce(_mm256_add_pd(acc0, acc1));
+    for (; i < n; i++)
+    {
+        ret_val += x[i] * x[i];
+    }
+    return ret_val;
+}
+
+__attribute__((target("avx2,fma"))) inline void avx2_axpy(float alpha, const float* x, float* y, size_t n)
+{
+    __m256 a = _mm256_set1_ps(alpha);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        _mm256_storeu_ps(y + i, _mm256_fmadd_ps(a, _mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i)));
+    }
+    for (; i < n; i++)
+    {
+        y[i] += alpha * x[i];
+    }
+}
+
+__attribute__((target("avx2,fma"))) inline void avx2_axpy(double alpha, const double* x, double* y, size_t n)
+{
+    __m256d a = _mm256_set1_pd(alpha);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        _mm256_storeu_pd(y + i, _mm256_fmadd_pd(a, _mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+    }
+    for (; i < n; i++)
+    {
+        y[i] += alpha * x[i];
+    }
+}
+
+//==========================================================AVX-512=================================================================
+//the tails are done with masked loads and stores
+__attribute__((target("avx512f"))) inline __mmask16 avx512_tail_mask16(size_t n)
+{
+    return (__mmask16) ((1u << n) - 1);
+}
+
+__attribute__((target("avx512f"))) inline __mmask8 avx512_tail_mask8(size_t n)
+{
+    return (__mmask8) ((1u << n) - 1);
+}
+
+__attribute__((target("avx512f"))) inline float avx512_sum(const float* x, size_t n)
+{
+    __m512 acc0 = _mm512_setzero_ps();
+    __m512 acc1 = _mm512_setzero_ps();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        acc0 = _mm512_add_ps(acc0, _mm512_loadu_ps(x + i));
+        acc1 = _mm512_add_ps(acc1, _mm512_loadu_ps(x + i + 16));
+    }
+    for (; i + 16 <= n; i += 16)
+    {
+        acc0 = _mm512_add_ps(acc0, _mm512_loadu_ps(x + i));
+    }
+    if (i < n)
+    {
+        acc1 = _mm512_add_ps(acc1, _mm512_maskz_loadu_ps(avx512_tail_mask16(n - i), x + i));
+    }
+    return _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1));
+}
+
+__attribute__((target("avx512f"))) inline double avx512_sum(const double* x, size_t n)
+{
+    __m512d acc0 = _mm512_setzero_pd();
+    __m512d acc1 = _mm512_setzero_pd();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        acc0 = _mm512_add_pd(acc0, _mm512_loadu_pd(x + i));
+        acc1 = _mm512_add_pd(acc1, _mm512_loadu_pd(x + i + 8));
+    }
+    for (; i + 8 <= n; i += 8)
+    {
+        acc0 = _mm512_add_pd(acc0, _mm512_loadu_pd(x + i));
+    }
+    if (i < n)
+    {
+        acc1 = _mm512_add_pd(acc1, _mm512_maskz_loadu_pd(avx512_tail_mask8(n - i), x + i));
+    }
+    return _mm512_reduce_add_pd(_mm512_add_pd(acc0, acc1));
+}
+
+__attribute__((target("avx512f"))) inline float avx512_sum_of_squares(const float* x, size_t n)
+{
+    __m512 acc0 = _mm512_setzero_ps();
+    __m512 acc1 = _mm512_setzero_ps();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        __m512 a = _mm512_loadu_ps(x + i);
+        __m512 b = _mm512_loadu_ps(x + i + 16);
+        acc0 = _mm512_fmadd_ps(a, a, acc0);
+        acc1 = _mm512_fmadd_ps(b, b, acc1);
+    }
+    for (; i + 16 <= n; i += 16)
+    {
+        __m512 a = _mm512_loadu_ps(x + i);
+        acc0 = _mm512_fmadd_ps(a, a, acc0);
+    }
+    if (i < n)
+    {
+        __m512 a = _mm512_maskz_loadu_ps(avx512_tail_mask16(n - i), x + i);
+        acc1 = _mm512_fmadd_ps(a, a, acc1);
+    }
+    return _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1));
+}
+
+__attribute__((target("avx512f"))) inline double avx512_sum_of_squares(const double* x, size_t n)
+{
+    __m512d acc0 = _mm512_setzero_pd();
+    __m512d acc1 = _mm512_setzero_pd();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m512d a = _mm512_loadu_pd(x + i);
+        __m512d b = _mm512_loadu_pd(x + i + 8);
+        acc0 = _mm512_fmadd_pd(a, a, acc0);
+        acc1 = _mm512_fmadd_pd(b, b, acc1);
+    }
+    for (; i + 8 <= n; i += 8)
+    {
+        __m512d a = _mm512_loadu_pd(x + i);
+        acc0 = _mm512_fmadd_pd(a, a, acc0);
+    }
+    if (i < n)
+    {
+        __m512d a = _mm512_maskz_loadu_pd(avx512_tail_mask8(n - i), x + i);
+        acc1 = _mm512_fmadd_pd(a, a, acc1);
+    }
+    return _mm512_reduce_add_pd(_mm512_add_pd(acc0, acc1));
+}
+
+__attribute__((target("avx512f"))) inline void avx512_axpy(float alpha, const float* x, float* y, size_t n)
+{
+    __m512 a = _mm512_set1_ps(alpha);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        _mm512_storeu_ps(y + i, _mm512_fmadd_ps(a, _mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i)));
+    }
+    if (i < n)
+    {
+        __mmask16 mask = avx512_tail_mask16(n - i);
+        __m512 result = _mm512_fmadd_ps(a, _mm512_maskz_loadu_ps(mask, x + i), _mm512_maskz_loadu_ps(mask, y + i));
+        _mm512_mask_storeu_ps(y + i, mask, result);
+    }
+}
+
+__attribute__((target("avx512f"))) inline void avx512_axpy(double alpha, const double* x, double* y, size_t n)
+{
+    __m512d a = _mm512_set1_pd(alpha);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        _mm512_storeu_pd(y + i, _mm512_fmadd_pd(a, _mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i)));
+    }
+    if (i < n)
+    {
+        __mmask8 mask = avx512_tail_mask8(n - i);
+        __m512d result = _mm512_fmadd_pd(a, _mm512_maskz_loadu_pd(mask, x + i), _mm512_maskz_loadu_pd(mask, y + i));
+        _mm512_mask_storeu_pd(y + i, mask, result);
+    }
+}
+
+//the bitset kernels of the avx512 level also need VPOPCNTDQ
+__attribute__((target("avx512f"))) inline size_t avx512_reduce_popcount(__m512i v)
+{
+    unsigned long long lanes[8];
+    _mm512_storeu_si512(lanes, v);
+    return (size_t) (lanes[0] + lanes[1] + lanes[2] + lanes[3] + lanes[4] + lanes[5] + lanes[6] + lanes[7]);
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq"))) inline size_t avx512_and_popcount(const unsigned long long* a, const unsigned long long* b, size_t words)
+{
+    __m512i acc = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + 8 <= words; i += 8)
+    {
+        __m512i x = _mm512_and_si512(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i));
+        acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(x));
+    }
+    if (i < words)
+    {
+        __mmask8 mask = avx512_tail_mask8(words - i);
+        __m512i x = _mm512_and_si512(_mm512_maskz_loadu_epi64(mask, a + i), _mm512_maskz_loadu_epi64(mask, b + i));
+        acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(x));
+    }
+    return avx512_reduce_popcount(acc);
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq"))) inline size_t avx512_xor_popcount(const unsigned long long* a, const unsigned long long* b, size_t words)
+{
+    __m512i acc = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + 8 <= words; i += 8)
+    {
+        __m512i x = _mm512_xor_si512(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i));
+        acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(x));
+    }
+    if (i < words)
+    {
+        __mmask8 mask = avx512_tail_mask8(words - i);
+        __m512i x = _mm512_xor_si512(_mm512_maskz_loadu_epi64(mask, a + i), _mm512_maskz_loadu_epi64(mask, b + i));
+        acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(x));
+    }
+    return avx512_reduce_popcount(acc);
+}
+#endif
+
+//==========================================================DISPATCH================================================================
+/*
+ * returns the best kernel level supported by the CPU (and the OS)
+ */
+inline int matrix_kernel_cpu_level()
+{
+#ifdef MATRIX_KERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        return MATRIX_KERNEL_AVX512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    {
+        return MATRIX_KERNEL_AVX2;
+    }
+#endif
+    return MATRIX_KERNEL_SCALAR;
+}
+
+/*
+ * returns the kernels of a type for a level, types without vector kernels get the scalar ones
+ * @pram: the level (MATRIX_KERNEL_*), it must be supported by the CPU
+ */
+template <typename T>
+MatrixKernelTable<T> matrix_kernel_table(int level)
+{
+    MatrixKernelTable<T> table = {scalar_sum<T>, scalar_sum_of_squares<T>, scalar_axpy<T>};
+    return table;
+}
+
+#ifdef MATRIX_KERNELS_X86
+template <>
+inline MatrixKernelTable<float> matrix_kernel_table<float>(int level)
+{
+    if (level >= MATRIX_KERNEL_AVX512)
+    {
+        MatrixKernelTable<float> table = {avx512_sum, avx512_sum_of_squares, avx512_axpy};
+        return table;
+    }
+    if (level == MATRIX_KERNEL_AVX2)
+    {
+        MatrixKernelTable<float> table = {avx2_sum, avx2_sum_of_squares, avx2_axpy};
+        return table;
+    }
+    MatrixKernelTable<float> table = {scalar_sum<float>, scalar_sum_of_squares<float>, scalar_axpy<float>};
+    return table;
+}
+
+template <>
+inline MatrixKernelTable<double> matrix_kernel_table<double>(int level)
+{
+    if (level >= MATRIX_KERNEL_AVX512)
+    {
+        MatrixKernelTable<double> table = {avx512_sum, avx512_sum_of_squares, avx512_axpy};
+        return table;
+    }
+    if (level == MATRIX_KERNEL_AVX2)
+    {
+        MatrixKernelTable<double> table = {avx2_sum, avx2_sum_of_squares, avx2_axpy};
+        return table;
+    }
+    MatrixKernelTable<double> table = {scalar_sum<double>, scalar_sum_of_squares<double>, scalar_axpy<double>};
+    return table;
+}
+#endif
+
+/*
+ * returns the bitset kernels for a level
+ * @pram: the level (MATRIX_KERNEL_*), it must be supported by the CPU
+ */
+inline BitKernelTable bit_kernel_table(int level)
+{
+#ifdef MATRIX_KERNELS_X86
+    __builtin_cpu_init();
+    if (level >= MATRIX_KERNEL_AVX512 && __builtin_cpu_supports("avx512vpopcntdq"))
+    {
+        BitKernelTable table = {avx512_and_popcount, avx512_xor_popcount};
+        return table;
+    }
+    if (level >= MATRIX_KERNEL_AVX2 && __builtin_cpu_supports("popcnt"))
+    {
+        BitKernelTable table = {popcnt_and_popcount, popcnt_xor_popcount};
+        return table;
+    }
+#endif
+    BitKernelTable table = {scalar_and_popcount, scalar_xor_popcount};
+    return table;
+}
+
+/*
+ * returns the kernels of a type, picked for the CPU the first time they are asked for
+ */
+template <typename T>
+MatrixKernelTable<T>& matrix_kernels()
+{
+    static MatrixKernelTable<T> table = matrix_kernel_table<T>(matrix_kernel_cpu_level());
+    return table;
+}
+
+/*
+ * returns the bitset kernels, picked for the CPU the first time they are asked for
+ */
+inline BitKernelTable& bit_kernels()
+{
+    static BitKernelTable table = bit_kernel_table(matrix_kernel_cpu_level());
+    return table;
+}
+
+/*
+ * returns the level of the kernels in use
+ */
+inline int& matrix_kernel_level()
+{
+    static int level = matrix_kernel_cpu_level();
+    return level;
+}
+
+/*
+ * switches the float, double and bitset kernels to a lower level (e.g. to compare them), the level is capped to what the CPU
+ * supports. Not thread safe, call it before the kernels are used by other threads. Returns the level in use.
+ * @pram: the level (MATRIX_KERNEL_*)
+ */
+inline int set_matrix_kernel_level(int level)
+{
+    level = std::max(MATRIX_KERNEL_SCALAR, std::min(level, matrix_kernel_cpu_level()));
+    matrix_kernel_level() = level;
+    matrix_kernels<float>() = matrix_kernel_table<float>(level);
+    matrix_kernels<double>() = matrix_kernel_table<double>(level);
+    bit_kernels() = bit_kernel_table(level);
+    return level;
+}
+
+/*
+ * returns the name of a kernel level
+ * @pram: the level (MATRIX_KERNEL_*)
+ */
+inline const char* matrix_kernel_name(int level)
+{
+    switch (level)
+    {
+        case MATRIX_KERNEL_AVX512: return "avx512";
+        case MATRIX_KERNEL_AVX2: return "avx2";
+        default: return "scalar";
+    }
+}
+
+//==========================================================KERNELS=================================================================
+/*
+ * returns the sum of an array
+ * @pram: the array
+ * @pram: number of elements
+ */
+template <typename T>
+inline T kernel_sum(const T* x, size_t n)
+{
+    return matrix_kernels<T>().sum(x, n);
+}
+
+/*
+ * returns the sum of the squares of an array (the squared frobenius norm of a matrix stored in it)
+ * @pram: the array
+ * @pram: number of elements
+ */
+template <typename T>
+inline T kernel_sum_of_squares(const T* x, size_t n)
+{
+    return matrix_kernels<T>().sum_of_squares(x, n);
+}
+
+/*
+ * y += alpha * x
+ * @pram: alpha
+ * @pram: x
+ * @pram: y
+ * @pram: number of elements
+ */
+template <typename T>
+inline void kernel_axpy(T alpha, const T* x, T* y, size_t n)
+{
+    matrix_kernels<T>().axpy(alpha, x, y, n);
+}
+
+/*
+ * returns the number of bits set in a AND b, e.g. the common neighbors of two rows of a BitsetGraph
+ * @pram: bitset a
+ * @pram: bitset b
+ * @pram: number of 64 bit words
+ */
+inline size_t kernel_and_popcount(const unsigned long long* a, const unsigned long long* b, size_t words)
+{
+    return bit_kernels().and_popcount(a, b, words);
+}
+
+/*
+ * returns the number of bits set in a XOR b, e.g. the entries where two rows of adjacency matrices disagree
+ * @pram: bitset a
+ * @pram: bitset b
+ * @pram: number of 64 bit words
+ */
+inline size_t kernel_xor_popcount(const unsigned long long* a, const unsigned long long* b, size_t words)
+{
+    return bit_kernels().xor_popcount(a, b, words);
+}
+
+/*
+ * sums[i] += sum of row i, for the rows given as pointers
+ * @pram: pointers to the rows
+ * @pram: number of rows
+ * @pram: number of columns
+ * @pram: the sums
+ */
+template <typename T>
+inline void kernel_row_sums(const T* const* rows, int number_of_rows, int cols, T* sums)
+{
+    const MatrixKernelTable<T>& kernels = matrix_kernels<T>();
+    for (int i = 0; i < number_of_rows; i++)
+    {
+        sums[i] += kernels.sum(rows[i], cols);
+    }
+}
+
+/*
+ * out = in^T with square tiles so that both the rows that are read and the rows that are written stay in the cache
+ * @pram: pointers to the rows of in (rows*cols)
+ * @pram: pointers to the rows of out (cols*rows)
+ * @pram: number of rows of in
+ * @pram: number of columns of in
+ */
+template <typename T>
+inline void kernel_transpose(const T* const* in, T* const* out, int rows, int cols)
+{
+    for (int ii = 0; ii < rows; ii += MATRIX_TRANSPOSE_TILE)
+    {
+        int i_end = std::min(rows, ii + MATRIX_TRANSPOSE_TILE);
+        for (int jj = 0; jj < cols; jj += MATRIX_TRANSPOSE_TILE)
+        {
+            int j_end = std::min(cols, jj + MATRIX_TRANSPOSE_TILE);
+            for (int i = ii; i < i_end; i++)
+            {
+                const T* row = in[i];
+                for (int j = jj; j < j_end; j++)
+                {
+                    out[j][i] = row[j];
+                }
+            }
+        }
+    }
+}
+
+/*
+ * c += a * b, blocked so that a panel of b is reused by a block of rows of a while it is in the cache. Every entry of c
+ * gets its products in the order of the inner index like the textbook loop.
+ * @pram: pointers to the rows of a (n*k)
+ * @pram: pointers to the rows of b (k*m)
+ * @pram: pointers to the rows of c (n*m)
+ * @pram: n
+ * @pram: k
+ * @pram: m
+ */
+template <typename T>
+inline void kernel_gemm(const T* const* a, const T* const* b, T* const* c, int n, int k, int m)
+{
+    const MatrixKernelTable<T>& kernels = matrix_kernels<T>();
+    for (int jj = 0; jj < m; jj += MATRIX_GEMM_BLOCK_COLS)
+    {
+        int width = std::min(m - jj, MATRIX_GEMM_BLOCK_COLS);
+        for (int pp = 0; pp < k; pp += MATRIX_GEMM_BLOCK_INNER)
+        {
+            int p_end = std::min(k, pp + MATRIX_GEMM_BLOCK_INNER);
+            for (int ii = 0; ii < n; ii += MATRIX_GEMM_BLOCK_ROWS)
+            {
+                int i_end = std::min(n, ii + MATRIX_GEMM_BLOCK_ROWS);
+                for (int i = ii; i < i_end; i++)
+                {
+                    for (int p = pp; p < p_end; p++)
+                    {
+                        if (a[i][p] != 0)
+                        {
+                            kernels.axpy(a[i][p], b[p] + jj, c[i] + jj, width);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/*
+ * fills an array with the pointers to the rows of a matrix stored row by row in one array
+ * @pram: the matrix
+ * @pram: number of rows
+ * @pram: number of columns
+ * @pram: the row pointers that get filled (rows entries)
+ */
+template <typename T, typename P>
+inline void row_pointers(T* edges, int rows, int cols, P* pointers)
+{
+    for (int i = 0; i < rows; i++)
+    {
+        pointers[i] = edges + (size_t) i * cols;
+    }
+}
+
+#endif
@@ -0,0 +1,351 @@
+/*********************************************************************************
+ * Pool of 64 byte aligned buffers used for the storage of the dense matrices and*
+ * the scratch arrays of the matching algorithms. Buffers are grouped in power of*
+ * two size classes and every thread keeps the released buffers of each class in *
+ * its own free list, so the matrices of a restart or of a pair reuse the buffers*
+ * of the previous one on the same thread without locks or heap allocations. This*
+ * only holds for threads that outlive their work: the pair threads, and the     *
+ * restart threads which are the HelperThreads of a pair thread; a thread that is*
+ * started for a single task takes its buffers from the heap and frees them when *
+ * it exits. The counters tell how many buffers were borrowed and how many of    *
+ * them had to be allocated on the heap, in a steady state run the second one    *
+ * does not grow. A thread keeps at most MATRIX_POOL_MAX_FREE buffers per class  *
+ * and MATRIX_POOL_MAX_RETAINED_BYTES in all, the buffers released above that cap*
+ * (e.g. the scores of one big pair) go back to the heap.                        *
+ *********************************************************************************/
+
+#ifndef _MatrixPool_h
+#define _MatrixPool_h
+
+#include <cstdlib>
+#include <cstddef>
+#include <vector>
+#include <atomic>
+#include <new>
+#include <algorithm>
+
+static const size_t MATRIX_POOL_ALIGNMENT = 64;
+static const int MATRIX_POOL_SIZE_CLASSES = 48;
+static const size_t MATRIX_POOL_MAX_FREE = 8;
+static const size_t MATRIX_POOL_MAX_RETAINED_BYTES = (size_t) 64 << 20;
+
+/*
+ * MatrixPool class definition and method declarations.
+ */
+class MatrixPool
+{
+private:
+    std::vector<void*> _free[MATRIX_POOL_SIZE_CLASSES];
+    size_t _retained_bytes;
+
+    MatrixPool();
+    MatrixPool(const MatrixPool&);
+    void operator=(const MatrixPool&);
+
+    static MatrixPool& _local();
+    static bool& _alive();
+    static int _sizeClass(size_t bytes);
+    static std::atomic<long long>& _requests();
+    static std::atomic<long long>& _heapAllocations();
+
+public:
+    /************
+     *Destructor*
+     ************/
+    ~MatrixPool();
+
+    /**********
+    *OPERATIONS*
+    **********/
+    static void* allocate(size_t bytes);
+    static void release(void* buffer, size_t bytes);
+
+    /***********
+     *ACCESSORS*
+     ***********/
+    static long long getNumberOfRequests();
+    static long long getNumberOfHeapAllocations();
+};
+
+/*
+ * array of T borrowed from the pool of the thread and given back when the array goes out of scope
+ */
+template <typename T>
+class PooledArray
+{
+private:
+    T* _data;
+    size_t _size;
+
+    PooledArray(const PooledArray<T>&);
+    void operator=(const PooledArray<T>&);
+
+public:
+    /**************
+     *Constructors*
+     **************/
+    explicit PooledArray(size_t size);
+    PooledArray(size_t size, const T& value);
+
+    /************
+     *Destructor*
+     ************/
+    ~PooledArray();
+
+    /***********
+     *ACCESSORS*
+     ***********/
+    size_t size() const;
+    T* data();
+    T& operator[](size_t index);
+    const T& operator[](size_t index) const;
+};
+
+//==========================================================CONSTRUCTORS============================================================
+/*
+ * MatrixPool constructor, every thread gets one the first time it borrows a buffer.
+ */
+inline MatrixPool::MatrixPool()
+{
+    this->_retained_bytes = 0;
+}
+
+/*
+ * PooledArray constructor, the values are not initialized.
+ * @pram size_t: number of elements
+ */
+template <typename T>
+inline PooledArray<T>::PooledArray(size_t size)
+{
+    this->_size = size;
+    this->_data = (T*) MatrixPool::allocate(size * sizeof(T));
+}
+
+/*
+ * PooledArray constructor.
+ * @pram size_t: number of elements
+ * @pram T: value of every element
+ */
+template <typename T>
+inline PooledArray<T>::PooledArray(size_t size, const T& value)
+{
+    this->_size = size;
+    this->_data = (T*) MatrixPool::allocate(size * sizeof(T));
+    std::fill(this->_data, this->_data + size, value);
+}
+
+//==========================================================DESTRUCTOR==============================================================
+/*
+ * MatrixPool destructor, frees the buffers of the thread when it exits.
+ */
+inline MatrixPool::~MatrixPool()
+{
+    MatrixPool::_alive() = false;
+    for (int c = 0; c < MATRIX_POOL_SIZE_CLASSES; c++)
+    {
+        for (int b = 0; b < this->_free[c].size(); b++)
+        {
+            free(this->_free[c][b]);
+        }
+    }
+}
+
+/*
+ * PooledArray destructor, gives the buffer back to the pool.
+ */
+template <typename T>
+inline PooledArray<T>::~PooledArray()
+{
+    MatrixPool::release(this->_data, this->_size * sizeof(T));
+}
+
+//===========================================================OPERATIONS================================================================
+/*
+ * Borrows a 64 byte aligned buffer of at least bytes bytes, throws std::bad_alloc if the heap is full.
+ * @pram size_t: size of the buffer in bytes
+ */
+inline void* MatrixPool::allocate(size_t bytes)
+{
+    int size_class = MatrixPool::_sizeClass(bytes);
+    MatrixPool::_requests()++;
+
+    if (MatrixPool::_alive())
+    {
+        MatrixPool& pool = MatrixPool::_local();
+        std::vector<void*>& free_list = pool._free[size_class];
+        if (!free_list.empty())
+        {
+            void* buffer = free_list.back();
+            free_list.pop_back();
+            pool._retained_bytes -= MATRIX_POOL_ALIGNMENT << size_class;
+            return buffer;
+        }
+    }
+
+    void* buffer = NULL;
+    if (posix_memalign(&buffer, MATRIX_POOL_ALIGNMENT, MATRIX_POOL_ALIGNMENT << size_class) != 0)
+    {
+        throw std::bad_alloc();
+    }
+    MatrixPool::_heapAllocations()++;
+    return buffer;
+}
+
+/*
+ * Gives a buffer back to the pool of the calling thread (it can come from another thread). When keeping it would
+ * pass MATRIX_POOL_MAX_RETAINED_BYTES the pool frees buffers of larger classes to make room, if that is not enough
+ * (or the free list of its class is full) the buffer goes back to the heap.
+ * @pram void*: the buffer, NULL is ignored
+ * @pram size_t: the size that was asked for when the buffer was borrowed
+ */
+inline void MatrixPool::release(void* buffer, size_t bytes)
+{
+    if (buffer == NULL)
+    {
+        return;
+    }
+    //buffers released while the thread exits (e.g. by static objects) go straight back to the heap
+    if (!MatrixPool::_alive())
+    {
+        free(buffer);
+        return;
+    }
+    int size_class = MatrixPool::_sizeClass(bytes);
+    size_t buffer_bytes = MATRIX_POOL_ALIGNMENT << size_class;
+    MatrixPool& pool = MatrixPool::_local();
+    std::vector<void*>& free_list = pool._free[size_class];
+
+    //the buffers of larger classes are given up first so the small, often borrowed ones stay in the pool
+    for (int c = MATRIX_POOL_SIZE_CLASSES - 1; c > size_class && buffer_bytes <= MATRIX_POOL_MAX_RETAINED_BYTES
+         && buffer_bytes > MATRIX_POOL_MAX_RETAINED_BYTES - pool._retained_bytes; c--)
+    {
+        while (!pool._free[c].empty() && buffer_bytes > MATRIX_POOL_MAX_RETAINED_BYTES - pool._retained_bytes)
+        {
+            free(pool._free[c].back());
+            pool._free[c].pop_back();
+            pool._retained_bytes -= MATRIX_POOL_ALIGNMENT << c;
+        }
+    }
+    if (free_list.size() < MATRIX_POOL_MAX_FREE && buffer_bytes <= MATRIX_POOL_MAX_RETAINED_BYTES - pool._retained_bytes)
+    {
+        free_list.push_back(buffer);
+        pool._retained_bytes += buffer_bytes;
+    }
+    else
+    {
+        free(buffer);
+    }
+}
+
+//===========================================================ACCESSORS===============================================================
+/*
+ * Returns the number of buffers that were borrowed by all the threads.
+ */
+inline long long MatrixPool::getNumberOfRequests()
+{
+    return MatrixPool::_requests();
+}
+
+/*
+ * Returns the number of buffers that were allocated on the heap because the free list of their size class was empty.
+ */
+inline long long MatrixPool::getNumberOfHeapAllocations()
+{
+    return MatrixPool::_heapAllocations();
+}
+
+/*
+ * Returns the number of elements.
+ */
+template <typename T>
+inline size_t PooledArray<T>::size() const
+{
+    return this->_size;
+}
+
+/*
+ * Returns a pointer to the first element.
+ */
+template <typename T>
+inline T* PooledArray<T>::data()
+{
+    return this->_data;
+}
+
+/*
+ * Returns an element.
+ * @pram size_t: index of the element
+ */
+template <typename T>
+inline T& PooledArray<T>::operator[](size_t index)
+{
+    return this->_data[index];
+}
+
+/*
+ * Returns an element.
+ * @pram size_t: index of the element
+ */
+template <typename T>
+inline const T& PooledArray<T>::operator[](size_t index) const
+{
+    return this->_data[index];
+}
+
+//===========================================================PRIVATE=================================================================
+/*
+ * Returns the pool of the calling thread.
+ */
+inline MatrixPool& MatrixPool::_local()
+{
+    static thread_local MatrixPool pool;
+    return pool;
+}
+
+/*
+ * Returns false once the pool of the calling thread was destroyed.
+ */
+inline bool& MatrixPool::_alive()
+{
+    static thread_local bool alive = true;
+    return alive;
+}
+
+/*
+ * Returns the size class of a buffer, class c holds buffers of MATRIX_POOL_ALIGNMENT << c bytes.
+ * @pram size_t: size of the buffer in bytes
+ */
+inline int MatrixPool::_sizeClass(size_t bytes)
+{
+    int size_class = 0;
+    while (size_class < MATRIX_POOL_SIZE_CLASSES && (MATRIX_POOL_ALIGNMENT << size_class) < bytes)
+    {
+        size_class++;
+    }
+    if (size_class >= MATRIX_POOL_SIZE_CLASSES || (MATRIX_POOL_ALIGNMENT << size_class) == 0)
+    {
+        throw std::bad_alloc();
+    }
+    return size_class;
+}
+
+/*
+ * Returns the counter of borrowed buffers.
+ */
+inline std::atomic<long long>& MatrixPool::_requests()
+{
+    static std::atomic<long long> requests(0);
+    return requests;
+}
+
+/*
+ * Returns the counter of heap allocations.
+ */
+inline std::atomic<long long>& MatrixPool::_heapAllocations()
+{
+    static std::atomic<long long> heap_allocations(0);
+    return heap_allocations;
+}
+
+//===================================================================================================================================
+#endif
@@ -1,6 +1,7 @@
 /************************************************************************************
  * SymMatrix Matrix Data Structure. This structure uses an array to store the values* 
- * of a lower triangular matrix.                                                     *
+ * of a lower triangular matrix. Column j of the upper triangle (the entries i <= j)  *
+ * is contiguous, the bulk operations run the kernels of MatrixKernels.h on them.     *
  ************************************************************************************/
 
 #ifndef _SymMatrix_h
@@ -16,20 +17,11 @@
 #include <fstream>
 #include "MatrixExceptions.h"
 #include "SparseElement.h"
+#include "GraphFile.h"
+#include "Lanczos.h"
+#include "MatrixKernels.h"
 #include "DenseMatrix1D.h"
 
-#ifdef EIGEN
-#include <Eigen/Dense>
-#include <Eigen/Sparse>
-#endif
-
-#ifdef ARPACK
-#include "dsmatrxa.h"
-#include "ardsmat.h"
-#include "ardssym.h"
-#include "lsymsol.h"
-#endif
-
 #ifdef USE_MPI
 #include "mpi.h"
 #include "MPI_Structs.h"
@@ -151,43 +143,24 @@ inline SymMatrix<T>::SymMatrix(bool fill)
 /*
  * SymMatrix constructor:
  * Construct a matrix by reading a matrix file, specified in readme.txt file the nodes that exist will have _DEFAULT_MATRIX_ENTRY value.
+ * The file is parsed by GraphFile, a malformed file throws MatrixReaderException.
  * @pram std::string : path to the file
  */
 template<typename T>
 inline SymMatrix<T>::SymMatrix(const std::string& file_path)
 {
-    int tmp_x;
-    int tmp_y;
-    std::ifstream file_reader;
-    file_reader.open(file_path.c_str());
-    
-    if(file_reader.fail())
+    GraphFile graph_file(file_path);
+    if (graph_file.getNumberOfRows() != graph_file.getNumberOfColumns())
     {
-        file_reader.close();
-        throw FileDoesNotExistException(file_path);
-    }
-    
-    file_reader >> this->_size;
-    file_reader >> tmp_x;
-    
-    
-    if (this->_size != tmp_x)
-    {
-        file_reader.close();
         throw NotASquareMatrixException();
     }
     
+    this->_size = graph_file.getNumberOfRows();
     _initializeMatrix(true);
-    file_reader >> tmp_x;      //skip the line number
-    
-    while (!file_reader.eof())
+    for (int k = 0; k < graph_file.getNumberOfEntries(); k++)
     {
-        file_reader >> tmp_x;
-        file_reader >> tmp_y;
-        (*this)(tmp_x - 1 ,tmp_y - 1) = 1;
+        (*this)(graph_file.getRow(k), graph_file.getColumn(k)) = 1;
     }
-    
-    file_reader.close();
 }
 
 /*
@@ -405,32 +378,45 @@ inline DenseMatrix1D<T> SymMatrix<T>::getScatteredSelection(const std::vector<in
 template <typename T>
 inline T SymMatrix<T>::getFrobNorm()
 {
-
+    //the entries off the diagonal are stored once but appear twice in the matrix
+    T diagonal = 0;
+    for (int j = 0; j < this->_size; j++)
+    {
+        T value = this->_edges[j + size_t(j)*(j+1)/2];
+        diagonal += value * value;
+    }
+    return 2 * kernel_sum_of_squares(this->_edges, this->_getArrSize()) - diagonal;
 }
 
 /*
- * Returns a std::vector<T> that contains the values of the eigenvector associated to the largest eigenvalue
+ * Returns an array (delete [] it after usage) that contains the values of the eigenvector associated to the largest eigenvalue,
+ * found with the Lanczos solver of Lanczos.h.
  */
 template <typename T>
 inline T* SymMatrix<T>::getTopEigenVector()
 {
-#ifdef ARPACK
-    ARdsSymMatrix<T> ARMatrix(this->_size, this->_edges, 'L');
-    ARluSymStdEig<T> eigProb(1, ARMatrix, "LM", 10);
-    eigProb.FindEigenvectors();
+    //y = A x on the full matrix, the start vector of ones is not orthogonal to the Perron vector
+    auto apply = [this](const double* x, double* y)
+    {
+        for (int i = 0; i < this->_size; i++)
+        {
+            double sum = 0;
+            for (int j = 0; j < this->_size; j++)
+            {
+                sum += (*this)(i, j) * x[j];
+            }
+            y[i] = sum;
+        }
+    };
+    std::vector<double> top(this->_size, 1.0);
+    lanczos_top_eigen(apply, top);
+
     T* eigen_vector = new T[this->_size];
-     
-    for (int i=0; i < this->_size; i++)
+    for (int i = 0; i < this->_size; i++)
     {
-        eigen_vector[i] = eigProb.Eigenvector(0,i);
+        eigen_vector[i] = top[i];
     }
-    
     return eigen_vector;
-#endif
-
-#ifdef EIGEN
-
-#endif
 }
 
 /*
@@ -439,6 +425,7 @@ inline T* SymMatrix<T>::getTopEigenVector()
 template <typename T>
 inline SymMatrix<T> SymMatrix<T>::transpose()
 {
+    return SymMatrix<T>(*this);
 }
 
 /*
@@ -447,6 +434,15 @@ inline SymMatrix<T> SymMatrix<T>::transpose()
 template <typename T>
 inline std::vector<T> SymMatrix<T>::getSumOfRows()
 {
+    //column j of the upper triangle is the start of row j and adds its entry (i,j) to the rows i < j
+    std::vector<T> sum_vec(this->_size);
+    for (int j = 0; j < this->_size; j++)
+    {
+        const T* column = this->_edges + size_t(j)*(j+1)/2;
+        sum_vec[j] += kernel_sum(column, j + 1);
+        kernel_axpy((T) 1, column, sum_vec.data(), j);
+    }
+    return sum_vec;
 }
 
 /*
@@ -639,6 +635,37 @@ inline DenseMatrix1D<T> SymMatrix<T>::operator-(const DenseMatrix1D<T>& other_ma
 template <typename T>
 inline DenseMatrix1D<T> SymMatrix<T>::operator*(const DenseMatrix1D<T>& other_matrix)
 {
+    if (this->_size != other_matrix.getNumberOfRows())
+    {
+        throw DimensionMismatchException();
+    }
+    int cols = other_matrix.getNumberOfColumns();
+    DenseMatrix1D<T> ret_matrix(this->_size, cols);
+    if (cols == 0)
+    {
+        return ret_matrix;
+    }
+
+    //the stored entry (i,j), i <= j, adds row i of other_matrix to row j of the product and row j to row i
+    for (int j = 0; j < this->_size; j++)
+    {
+        const T* column = this->_edges + size_t(j)*(j+1)/2;
+        T* ret_row_j = &ret_matrix(j, 0);
+        const T* other_row_j = &other_matrix(j, 0);
+        for (int i = 0; i <= j; i++)
+        {
+            if (column[i] == 0)
+            {
+                continue;
+            }
+            kernel_axpy(column[i], &other_matrix(i, 0), ret_row_j, cols);
+            if (i < j)
+            {
+                kernel_axpy(column[i], other_row_j, &ret_matrix(i, 0), cols);
+            }
+        }
+    }
+    return ret_matrix;
 }
 
 /*
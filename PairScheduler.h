@@ -0,0 +1,269 @@
+/*********************************************************************************
+ * This file contains the PairScheduler class used by the sequential build to    *
+ * run the graph comparisons on all the cores of a node. Every worker thread     *
+ * owns a deque of task indices, it takes tasks from the front of its own deque  *
+ * and when the deque is empty it steals from the back of the deque of another   *
+ * worker, so slow comparisons do not leave the other threads idle. Tasks are    *
+ * identified by their index so the caller can store the results in task order.  *
+ * When the tasks are given in order of decreasing cost they are dealt out       *
+ * round robin, every worker starts with its most expensive task and thieves     *
+ * take the cheapest ones. An exception thrown by a task stops the workers from  *
+ * taking new tasks and is rethrown by run() once every thread has joined.       *
+ *********************************************************************************/
+
+#ifndef _PairScheduler_h
+#define _PairScheduler_h
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <exception>
+
+/*
+ * PairScheduler class definition and method declarations.
+ */
+class PairScheduler
+{
+private:
+    /*
+     * the tasks owned by one worker
+     */
+    struct WorkerQueue
+    {
+        std::mutex lock;
+        std::deque<int> tasks;
+    };
+
+    bool _popOwn(int worker, int* task);
+    bool _steal(int worker, int* task);
+
+    template <typename Work>
+    void _workerLoop(int worker, Work& work);
+
+protected:
+    int _num_tasks;
+    int _num_threads;
+    std::vector<WorkerQueue*> _queues;
+    std::atomic<bool> _failed;
+    std::mutex _error_lock;
+    std::exception_ptr _error;
+
+public:
+    /**************
+     *Constructors*
+     **************/
+    PairScheduler(int num_tasks, int num_threads);
+    PairScheduler(const std::vector<int>& tasks, int num_threads);
+
+    /************
+     *Destructor*
+     ************/
+    virtual ~PairScheduler();
+
+    /***********
+     *ACCESSORS*
+     ***********/
+    int getNumberOfThreads() const;
+
+    /**********
+    *OPERATIONS*
+    **********/
+    template <typename Work>
+    void run(Work& work);
+
+    static int defaultNumberOfThreads();
+};
+
+//==========================================================CONSTRUCTORS============================================================
+/*
+ * PairScheduler constructor:
+ * Splits the tasks 0..num_tasks-1 in contiguous blocks, one block per worker.
+ * @pram int: number of tasks
+ * @pram int: number of worker threads, values < 1 use defaultNumberOfThreads()
+ */
+inline PairScheduler::PairScheduler(int num_tasks, int num_threads)
+{
+    this->_failed = false;
+    if (num_threads < 1)
+    {
+        num_threads = PairScheduler::defaultNumberOfThreads();
+    }
+    this->_num_tasks = num_tasks;
+    this->_num_threads = num_threads;
+
+    for (int t = 0; t < num_threads; t++)
+    {
+        WorkerQueue* queue = new WorkerQueue();
+        long block_start = (long) num_tasks * t / num_threads;
+        long block_end = (long) num_tasks * (t + 1) / num_threads;
+        for (long task = block_start; task < block_end; task++)
+        {
+            queue->tasks.push_back(task);
+        }
+        this->_queues.push_back(queue);
+    }
+}
+
+/*
+ * PairScheduler constructor:
+ * Deals the tasks round robin in the given order, tasks[0] goes to worker 0, tasks[1] to worker 1...
+ * @pram std::vector<int>: task indices, usually sorted by decreasing cost
+ * @pram int: number of worker threads, values < 1 use defaultNumberOfThreads()
+ */
+inline PairScheduler::PairScheduler(const std::vector<int>& tasks, int num_threads)
+{
+    this->_failed = false;
+    if (num_threads < 1)
+    {
+        num_threads = PairScheduler::defaultNumberOfThreads();
+    }
+    this->_num_tasks = tasks.size();
+    this->_num_threads = num_threads;
+
+    for (int t = 0; t < num_threads; t++)
+    {
+        this->_queues.push_back(new WorkerQueue());
+    }
+    for (int k = 0; k < tasks.size(); k++)
+    {
+        this->_queues[k % num_threads]->tasks.push_back(tasks[k]);
+    }
+}
+
+//==========================================================DESTRUCTOR==============================================================
+/*
+ * PairScheduler destructor.
+ */
+inline PairScheduler::~PairScheduler()
+{
+    for (int t = 0; t < this->_queues.size(); t++)
+    {
+        delete this->_queues[t];
+    }
+}
+
+//===========================================================ACCESSORS===============================================================
+/*
+ * Returns the number of worker threads.
+ */
+inline int PairScheduler::getNumberOfThreads() const
+{
+    return this->_num_threads;
+}
+
+//===========================================================OPERATIONS================================================================
+/*
+ * Runs work(task, worker) for every task on the worker threads and returns when all tasks are done.
+ * work is called concurrently, it must only write to data owned by the task (e.g. results[task]).
+ * If a task throws, the tasks that were not started are dropped and the first exception is rethrown here
+ * after all the threads have joined (an exception escaping a std::thread would call std::terminate).
+ * @pram Work: functor or lambda taking (int task, int worker)
+ */
+template <typename Work>
+inline void PairScheduler::run(Work& work)
+{
+    if (this->_num_threads == 1)
+    {
+        this->_workerLoop(0, work);
+    }
+    else
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < this->_num_threads; t++)
+        {
+            threads.push_back(std::thread(&PairScheduler::_workerLoop<Work>, this, t, std::ref(work)));
+        }
+        for (int t = 0; t < threads.size(); t++)
+        {
+            threads[t].join();
+        }
+    }
+
+    if (this->_error)
+    {
+        std::rethrow_exception(this->_error);
+    }
+}
+
+/*
+ * Returns the number of hardware threads of the node (1 if unknown).
+ */
+inline int PairScheduler::defaultNumberOfThreads()
+{
+    int hardware_threads = std::thread::hardware_concurrency();
+    return (hardware_threads > 0) ? hardware_threads : 1;
+}
+
+//===========================================================PRIVATE=================================================================
+/*
+ * Runs the tasks of a worker, then the tasks stolen from the other workers until none are left.
+ * Tasks are never added after the start so an empty pass over all the queues means we are done.
+ * The first exception of a task is kept for run() and every worker stops at its next task.
+ * @pram int: worker id
+ * @pram Work: functor or lambda taking (int task, int worker)
+ */
+template <typename Work>
+inline void PairScheduler::_workerLoop(int worker, Work& work)
+{
+    int task;
+    while (!this->_failed && (this->_popOwn(worker, &task) || this->_steal(worker, &task)))
+    {
+        try
+        {
+            work(task, worker);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> guard(this->_error_lock);
+            if (!this->_error)
+            {
+                this->_error = std::current_exception();
+            }
+            this->_failed = true;
+        }
+    }
+}
+
+/*
+ * Takes the next task from the front of the worker's own deque.
+ * @pram int: worker id
+ * @pram int*: the task that was taken
+ */
+inline bool PairScheduler::_popOwn(int worker, int* task)
+{
+    WorkerQueue* queue = this->_queues[worker];
+    std::lock_guard<std::mutex> guard(queue->lock);
+    if (queue->tasks.empty())
+    {
+        return false;
+    }
+    *task = queue->tasks.front();
+    queue->tasks.pop_front();
+    return true;
+}
+
+/*
+ * Takes a task from the back of the deque of another worker, starting with the next worker.
+ * @pram int: worker id of the thief
+ * @pram int*: the task that was stolen
+ */
+inline bool PairScheduler::_steal(int worker, int* task)
+{
+    for (int offset = 1; offset < this->_num_threads; offset++)
+    {
+        WorkerQueue* victim = this->_queues[(worker + offset) % this->_num_threads];
+        std::lock_guard<std::mutex> guard(victim->lock);
+        if (!victim->tasks.empty())
+        {
+            *task = victim->tasks.back();
+            victim->tasks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+//===================================================================================================================================
+#endif
@@ -0,0 +1,107 @@
+/*********************************************************************************
+ * This file contains the Random class, a small random number generator that is  *
+ * passed to the matching algorithms instead of using the global rand(). Every   *
+ * graph pair gets its own generator seeded from the run seed and the indices of *
+ * the pair, so the results do not depend on how pairs are spread over threads   *
+ * or processors and a run can be repeated with the same seed.                   *
+ *********************************************************************************/
+
+#ifndef _Random_h
+#define _Random_h
+
+/*
+ * Random class definition and method declarations.
+ */
+class Random
+{
+protected:
+    unsigned long long _state;
+    int _choices;
+
+public:
+    /**************
+     *Constructors*
+     **************/
+    Random(unsigned long long seed = 0);
+
+    /**********
+    *OPERATIONS*
+    **********/
+    void setSeed(unsigned long long seed);
+    unsigned int next();
+    int nextInt(int bound);
+    int getNumberOfChoices() const;
+    static unsigned long long pairSeed(unsigned long long seed, int i, int j);
+};
+
+//==========================================================CONSTRUCTORS============================================================
+/*
+ * Random constructor.
+ * @pram unsigned long long: seed
+ */
+inline Random::Random(unsigned long long seed)
+{
+    this->setSeed(seed);
+}
+
+//===========================================================OPERATIONS================================================================
+/*
+ * Restarts the sequence of numbers from a seed.
+ * @pram unsigned long long: seed
+ */
+inline void Random::setSeed(unsigned long long seed)
+{
+    this->_state = seed;
+    this->_choices = 0;
+}
+
+/*
+ * Returns the next 32 bit number of the sequence (splitmix64).
+ */
+inline unsigned int Random::next()
+{
+    unsigned long long z = (this->_state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return (unsigned int) ((z ^ (z >> 31)) >> 32);
+}
+
+/*
+ * Returns a number in [0, bound), used in place of rand() % bound.
+ * @pram int: bound, must be positive
+ */
+inline int Random::nextInt(int bound)
+{
+    if (bound > 1)
+    {
+        this->_choices++;
+    }
+    return (int) (this->next() % (unsigned int) bound);
+}
+
+/*
+ * Returns the number of calls to nextInt with more than one possible result since the seed was set.
+ * 0 means the numbers did not change anything, any other seed would have given the same choices.
+ */
+inline int Random::getNumberOfChoices() const
+{
+    return this->_choices;
+}
+
+/*
+ * Returns the seed of the generator used for the comparison of graph i and graph j.
+ * @pram unsigned long long: seed of the run
+ * @pram int: index of the first graph
+ * @pram int: index of the second graph
+ */
+inline unsigned long long Random::pairSeed(unsigned long long seed, int i, int j)
+{
+    Random mixer(seed ^ (((unsigned long long) (unsigned int) i << 32) | (unsigned int) j));
+    //the two halves are drawn in separate statements so the order does not depend on the compiler
+    unsigned long long high = mixer.next();
+    unsigned long long low = mixer.next();
+    return (high << 32) | low;
+}
+
+//===================================================================================================================================
+#endif
@@ -0,0 +1,548 @@
+/*************************************************************************************
+ * This file contains the SpectralCache class, the top eigenpairs of the normalized  *
+ * adjacency matrix D^-1/2 A D^-1/2 of a graph for each of its connected components. *
+ * The normalized product operator of IsoRank is the kronecker product of the        *
+ * normalized factors, so the eigenvectors of the product are kronecker products of  *
+ * the cached eigenvectors: a cache is built once per graph when it is loaded and    *
+ * the scores of every pair are assembled from two caches without an eigensolve.     *
+ * The components of the product follow from the components of the factors and     *
+ * their bipartite sides (Weichsel), so the product graph is never built either.    *
+ * The eigensolves run in double or in mixed precision (float iterations refined in  *
+ * double, see lanczos_top_eigen_mixed).                                             *
+ *************************************************************************************/
+
+#ifndef _SpectralCache_h
+#define _SpectralCache_h
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "Matrices/DenseMatrix1D.h"
+#include "Matrices/CSRGraph.h"
+#include "Matrices/Lanczos.h"
+#include "ConnectedComponents.h"
+
+//precision of the eigensolves of the caches
+static const int EIGEN_PRECISION_DOUBLE = 0;
+static const int EIGEN_PRECISION_MIXED = 1;
+
+/*
+ * returns the precision used by the caches that are built without one (EIGEN_PRECISION_DOUBLE unless it was changed),
+ * set it before the caches are built by other threads
+ */
+inline int& default_eigen_precision()
+{
+    static int precision = EIGEN_PRECISION_DOUBLE;
+    return precision;
+}
+
+/*
+ * SpectralCache class definition and method declarations.
+ */
+class SpectralCache
+{
+protected:
+    int _nodes;
+    std::vector<int> _component;
+    std::vector<int> _component_edges;
+    std::vector<int> _members;
+    std::vector<int> _members_begin;
+    std::vector<char> _bipartite;
+    std::vector<int> _first_node;
+    std::vector<char> _side;
+    std::vector<double> _eigenvalue;
+    std::vector<double> _eigenvector;
+    std::vector<double> _d_neg0pt5;
+    int _precision;
+    int _low_applications;
+    int _applications;
+
+public:
+    /**************
+     *Constructors*
+     **************/
+    explicit SpectralCache(const CSRGraph& graph, int precision = default_eigen_precision());
+
+    /***********
+     *ACCESSORS*
+     ***********/
+    int getNumberOfNodes() const;
+    int getNumberOfComponents() const;
+    int getComponent(int vertex) const;
+    const int* membersBegin(int component) const;
+    const int* membersEnd(int component) const;
+    bool hasEdges(int component) const;
+    bool isBipartite(int component) const;
+    int getSide(int vertex) const;
+    int getFirstNode(int component, int side) const;
+    double getEigenvalue(int component) const;
+    double getEigenvectorEntry(int vertex) const;
+    double getInverseSqrtDegree(int vertex) const;
+    int getPrecision() const;
+    int getNumberOfLowPrecisionApplications() const;
+    int getNumberOfApplications() const;
+};
+
+/*
+ * a connected component of the product A kron B with edges: the product of component_A and component_B when
+ * one of them is not bipartite, otherwise one of the two halves of that product (half 0 holds the nodes (i,k)
+ * where i and k are on the same side, half 1 the others). first_node is its smallest product node i*m + k.
+ */
+struct ProductComponent
+{
+    int component_A;
+    int component_B;
+    int half;
+    int first_node;
+};
+
+//==========================================================CONSTRUCTORS============================================================
+/*
+ * SpectralCache constructor:
+ * Labels the connected components (numbered in the order of their first node), 2-colours them to find the
+ * bipartite ones and finds the top eigenpair of the normalized adjacency matrix restricted to every component
+ * that has edges with the Lanczos solver.
+ * @pram CSRGraph: the graph
+ * @pram int: precision of the eigensolves (EIGEN_PRECISION_DOUBLE or EIGEN_PRECISION_MIXED)
+ */
+inline SpectralCache::SpectralCache(const CSRGraph& graph, int precision)
+{
+    this->_nodes = graph.getNumberOfNodes();
+    this->_precision = precision;
+    this->_low_applications = 0;
+    this->_applications = 0;
+    this->_eigenvector.assign(this->_nodes, 0);
+    this->_d_neg0pt5.resize(this->_nodes);
+    for (int i = 0; i < this->_nodes; i++)
+    {
+        int degree = graph.getDegree(i);
+        this->_d_neg0pt5[i] = (degree > 0) ? 1.0/sqrt((double) degree) : 0;
+    }
+
+    //the nodes of a component are contiguous in order, in the order the breadth first search found them
+    std::vector<int> order;
+    int number_of_components = connected_components(graph, this->_component, order);
+    this->_component_edges.assign(number_of_components, 0);
+    this->_eigenvalue.assign(number_of_components, 0);
+    this->_bipartite.assign(number_of_components, 1);
+    this->_first_node.assign(2 * number_of_components, -1);
+    this->_side.assign(this->_nodes, -1);
+    std::vector<int> local_index(this->_nodes, -1);
+    std::vector<float> d_neg0pt5_low;
+    if (this->_precision == EIGEN_PRECISION_MIXED)
+    {
+        d_neg0pt5_low.assign(this->_d_neg0pt5.begin(), this->_d_neg0pt5.end());
+    }
+    int begin = 0;
+    for (int label = 0; label < number_of_components; label++)
+    {
+        int end = begin;
+        int edges = 0;
+        while (end < this->_nodes && this->_component[order[end]] == label)
+        {
+            local_index[order[end]] = end - begin;
+            edges += graph.getDegree(order[end]);
+            end++;
+        }
+        const int* members = &order[begin];
+        int size = end - begin;
+        begin = end;
+        this->_component_edges[label] = edges;
+
+        //every node is found by a node before it in the search order, so one pass colours the component
+        this->_side[members[0]] = 0;
+        for (int local = 0; local < size; local++)
+        {
+            int i = members[local];
+            for (const int* j = graph.neighborsBegin(i); j != graph.neighborsEnd(i); j++)
+            {
+                if (this->_side[*j] == -1)
+                {
+                    this->_side[*j] = 1 - this->_side[i];
+                }
+                else if (this->_side[*j] == this->_side[i])
+                {
+                    this->_bipartite[label] = 0;
+                }
+            }
+            int& first = this->_first_node[2*label + this->_side[i]];
+            if (first == -1 || i < first)
+            {
+                first = i;
+            }
+        }
+        if (edges == 0)
+        {
+            continue;
+        }
+
+        //y = D^-1/2 A D^-1/2 x on the nodes of the component
+        const std::vector<double>& d_neg0pt5 = this->_d_neg0pt5;
+        auto apply = [&](const double* x, double* y)
+        {
+            for (int local = 0; local < size; local++)
+            {
+                int i = members[local];
+                double sum = 0;
+                for (const int* j = graph.neighborsBegin(i); j != graph.neighborsEnd(i); j++)
+                {
+                    sum += d_neg0pt5[*j] * x[local_index[*j]];
+                }
+                y[local] = d_neg0pt5[i] * sum;
+            }
+        };
+        std::vector<double> top(size, 1.0);
+        if (this->_precision == EIGEN_PRECISION_MIXED)
+        {
+            //the same operator on float vectors with float weights
+            auto apply_low = [&](const float* x, float* y)
+            {
+                for (int local = 0; local < size; local++)
+                {
+                    int i = members[local];
+                    float sum = 0;
+                    for (const int* j = graph.neighborsBegin(i); j != graph.neighborsEnd(i); j++)
+                    {
+                        sum += d_neg0pt5_low[*j] * x[local_index[*j]];
+                    }
+                    y[local] = d_neg0pt5_low[i] * sum;
+                }
+            };
+            this->_eigenvalue[label] = lanczos_top_eigen_mixed(apply_low, apply, top, LANCZOS_TOL, LANCZOS_MAX_IT, LANCZOS_BASIS_SIZE,
+                                                               &this->_low_applications, &this->_applications);
+        }
+        else
+        {
+            this->_eigenvalue[label] = lanczos_top_eigen(apply, top, LANCZOS_TOL, LANCZOS_MAX_IT, LANCZOS_BASIS_SIZE,
+                                                         &this->_applications);
+        }
+        for (int local = 0; local < size; local++)
+        {
+            this->_eigenvector[members[local]] = top[local];
+        }
+    }
+
+    //the members of every component in increasing order, the scores of a pair are assembled from them
+    this->_members.swap(order);
+    this->_members_begin.assign(number_of_components + 1, 0);
+    for (int label = 0; label < number_of_components; label++)
+    {
+        int end = this->_members_begin[label];
+        while (end < this->_nodes && this->_component[this->_members[end]] == label)
+        {
+            end++;
+        }
+        this->_members_begin[label + 1] = end;
+        std::sort(this->_members.begin() + this->_members_begin[label], this->_members.begin() + end);
+    }
+}
+
+//===========================================================ACCESSORS===============================================================
+/*
+ * Returns the number of nodes of the graph.
+ */
+inline int SpectralCache::getNumberOfNodes() const
+{
+    return this->_nodes;
+}
+
+/*
+ * Returns the number of connected components (isolated nodes are components without edges).
+ */
+inline int SpectralCache::getNumberOfComponents() const
+{
+    return this->_component_edges.size();
+}
+
+/*
+ * Returns the component of a node.
+ * @pram int vertex
+ */
+inline int SpectralCache::getComponent(int vertex) const
+{
+    return this->_component[vertex];
+}
+
+/*
+ * Returns a pointer to the first node of a component, the nodes of a component are in increasing order.
+ * @pram int component
+ */
+inline const int* SpectralCache::membersBegin(int component) const
+{
+    return this->_members.data() + this->_members_begin[component];
+}
+
+/*
+ * Returns a pointer past the last node of a component.
+ * @pram int component
+ */
+inline const int* SpectralCache::membersEnd(int component) const
+{
+    return this->_members.data() + this->_members_begin[component + 1];
+}
+
+/*
+ * Returns true if a component has at least one edge (only those have an eigenpair).
+ * @pram int component
+ */
+inline bool SpectralCache::hasEdges(int component) const
+{
+    return this->_component_edges[component] > 0;
+}
+
+/*
+ * Returns true if a component has no odd cycle (a self loop is an odd cycle), isolated nodes are bipartite.
+ * @pram int component
+ */
+inline bool SpectralCache::isBipartite(int component) const
+{
+    return this->_bipartite[component] != 0;
+}
+
+/*
+ * Returns the side (0 or 1) of a node in the 2-colouring of its component, the side of the smallest node of a
+ * component is 0. Only meaningful in bipartite components.
+ * @pram int vertex
+ */
+inline int SpectralCache::getSide(int vertex) const
+{
+    return this->_side[vertex];
+}
+
+/*
+ * Returns the smallest node of a component on a side, -1 if the side is empty.
+ * @pram int component
+ * @pram int side: 0 or 1
+ */
+inline int SpectralCache::getFirstNode(int component, int side) const
+{
+    return this->_first_node[2*component + side];
+}
+
+/*
+ * Returns the top eigenvalue of the normalized adjacency matrix of a component (1 for every component with edges).
+ * @pram int component
+ */
+inline double SpectralCache::getEigenvalue(int component) const
+{
+    return this->_eigenvalue[component];
+}
+
+/*
+ * Returns the entry of a node in the normalized top eigenvector of its component (the sign is arbitrary).
+ * @pram int vertex
+ */
+inline double SpectralCache::getEigenvectorEntry(int vertex) const
+{
+    return this->_eigenvector[vertex];
+}
+
+/*
+ * Returns D^-1/2 of a node (0 for isolated nodes).
+ * @pram int vertex
+ */
+inline double SpectralCache::getInverseSqrtDegree(int vertex) const
+{
+    return this->_d_neg0pt5[vertex];
+}
+
+/*
+ * Returns the precision of the eigensolves (EIGEN_PRECISION_DOUBLE or EIGEN_PRECISION_MIXED).
+ */
+inline int SpectralCache::getPrecision() const
+{
+    return this->_precision;
+}
+
+/*
+ * Returns how many times the normalized adjacency matrix was applied to a float vector (mixed precision only).
+ */
+inline int SpectralCache::getNumberOfLowPrecisionApplications() const
+{
+    return this->_low_applications;
+}
+
+/*
+ * Returns how many times the normalized adjacency matrix was applied to a double vector.
+ */
+inline int SpectralCache::getNumberOfApplications() const
+{
+    return this->_applications;
+}
+
+//===================================================================================================================================
+/*
+ * compares the eigenpairs of two caches of the same graph (e.g. mixed precision against double), the largest
+ * difference of an eigenvalue and of an eigenvector entry are written out. The sign of the eigenvector of every
+ * component is arbitrary, it is aligned before the entries are compared.
+ * @pram: spectral cache
+ * @pram: spectral cache of the same graph
+ * @pram: the largest difference of the eigenvalues
+ * @pram: the largest difference of the eigenvector entries
+ */
+inline void spectral_cache_deviation(const SpectralCache& cache, const SpectralCache& reference,
+                                     double* eigenvalue_deviation, double* eigenvector_deviation)
+{
+    *eigenvalue_deviation = 0;
+    *eigenvector_deviation = 0;
+    int components = cache.getNumberOfComponents();
+    std::vector<double> alignment(components, 0);
+    for (int i = 0; i < cache.getNumberOfNodes(); i++)
+    {
+        alignment[cache.getComponent(i)] += cache.getEigenvectorEntry(i) * reference.getEigenvectorEntry(i);
+    }
+    for (int c = 0; c < components; c++)
+    {
+        *eigenvalue_deviation = std::max(*eigenvalue_deviation, fabs(cache.getEigenvalue(c) - reference.getEigenvalue(c)));
+    }
+    for (int i = 0; i < cache.getNumberOfNodes(); i++)
+    {
+        double sign = (alignment[cache.getComponent(i)] < 0) ? -1 : 1;
+        *eigenvector_deviation = std::max(*eigenvector_deviation,
+                                          fabs(cache.getEigenvectorEntry(i) - sign * reference.getEigenvectorEntry(i)));
+    }
+}
+
+//===================================================================================================================================
+/*
+ * lists the connected components of A kron B that have edges, in the order of their smallest product node.
+ * By Weichsel's theorem the product of two connected graphs with edges is connected unless both are bipartite,
+ * then it has two components (the halves of ProductComponent). Products with an isolated node have no edges.
+ * The smallest node of a product component is in the row of the smallest node of the component of A, which
+ * like the smallest node of every component is on side 0.
+ * @pram: spectral cache of graph A
+ * @pram: spectral cache of graph B
+ * @pram: the components that get filled
+ */
+inline void plan_product_components(const SpectralCache& cache_A, const SpectralCache& cache_B,
+                                    std::vector<ProductComponent>& plan)
+{
+    int m = cache_B.getNumberOfNodes();
+    plan.clear();
+    for (int a = 0; a < cache_A.getNumberOfComponents(); a++)
+    {
+        if (!cache_A.hasEdges(a))
+        {
+            continue;
+        }
+        int first_A = cache_A.getFirstNode(a, 0);
+        for (int b = 0; b < cache_B.getNumberOfComponents(); b++)
+        {
+            if (!cache_B.hasEdges(b))
+            {
+                continue;
+            }
+            ProductComponent component;
+            component.component_A = a;
+            component.component_B = b;
+            if (!cache_A.isBipartite(a) || !cache_B.isBipartite(b))
+            {
+                component.half = -1;
+                component.first_node = first_A*m + cache_B.getFirstNode(b, 0);
+                plan.push_back(component);
+                continue;
+            }
+            //first_A is on side 0, so half 0 starts at the smallest node of side 0 of b and half 1 at side 1
+            for (int half = 0; half < 2; half++)
+            {
+                component.half = half;
+                component.first_node = first_A*m + cache_B.getFirstNode(b, half);
+                plan.push_back(component);
+            }
+        }
+    }
+    std::sort(plan.begin(), plan.end(),
+              [](const ProductComponent& x, const ProductComponent& y) { return x.first_node < y.first_node; });
+}
+
+/*
+ * writes the scores of a connected component of A kron B assembled from the spectral caches of A and B into the
+ * n*m scores matrix: the top eigenvector of the product operator restricted to the component without solving its
+ * eigenproblem. The component lies in the product of a component a of A and a component b of B. The top eigenvalue
+ * 1*1 of the product has the eigenvector u_a kron u_b; when a and b are both bipartite the product splits into two
+ * components and (-1)*(-1) = 1 adds the eigenvector u'_a kron u'_b (u' flips the sign of one side), the eigenvector
+ * of each half is (u_a kron u_b +- u'_a kron u'_b)/2 which is u_a kron u_b restricted to the half. So in every case
+ * the eigenvector is u_a kron u_b restricted to the component. It is scaled by D^1/2, normalized and its sign is
+ * fixed so that the first entry in the component is positive. Only the members of a and b are visited, O(|a| |b|);
+ * the entries outside the component are not written, they must be 0 (a new matrix, or one cleared with
+ * clear_product_component after the previous component). Returns false if the component has no edges.
+ * @pram: spectral cache of graph A
+ * @pram: spectral cache of graph B
+ * @pram: the component of the product (see plan_product_components)
+ * @pram: the scores matrix that gets filled (n*m)
+ */
+template <typename T>
+bool cached_top_eigen_matrix(const SpectralCache& cache_A, const SpectralCache& cache_B,
+                             const ProductComponent& component, DenseMatrix1D<T>& scores)
+{
+    int m = cache_B.getNumberOfNodes();
+    const int* begin_A = cache_A.membersBegin(component.component_A);
+    const int* end_A = cache_A.membersEnd(component.component_A);
+    const int* begin_B = cache_B.membersBegin(component.component_B);
+    const int* end_B = cache_B.membersEnd(component.component_B);
+
+    //x = D^1/2 (u_a kron u_b) on the component, the nodes are visited in row major order
+    auto entry = [&](int i, int k)
+    {
+        double d_neg0pt5 = cache_A.getInverseSqrtDegree(i) * cache_B.getInverseSqrtDegree(k);
+        return (d_neg0pt5 > 0) ? cache_A.getEigenvectorEntry(i) * cache_B.getEigenvectorEntry(k) / d_neg0pt5 : 0.0;
+    };
+
+    double vecLength = 0;
+    for (const int* i = begin_A; i != end_A; i++)
+    {
+        for (const int* k = begin_B; k != end_B; k++)
+        {
+            if (component.half == -1 || (cache_A.getSide(*i) ^ cache_B.getSide(*k)) == component.half)
+            {
+                double x = entry(*i, *k);
+                vecLength += x * x;
+            }
+        }
+    }
+    if (vecLength == 0)
+    {
+        return false;
+    }
+    vecLength = sqrt(vecLength);
+
+    int coef = 1;
+    if (entry(component.first_node / m, component.first_node % m) < 0)
+    {
+        coef = -1;
+    }
+
+    for (const int* i = begin_A; i != end_A; i++)
+    {
+        for (const int* k = begin_B; k != end_B; k++)
+        {
+            if (component.half == -1 || (cache_A.getSide(*i) ^ cache_B.getSide(*k)) == component.half)
+            {
+                scores(*i,*k) = coef * (entry(*i, *k)/vecLength);
+            }
+        }
+    }
+    return true;
+}
+
+/*
+ * sets the entries of a connected component of A kron B in the scores matrix back to 0, O(|a| |b|)
+ * @pram: spectral cache of graph A
+ * @pram: spectral cache of graph B
+ * @pram: the component of the product
+ * @pram: the scores matrix
+ */
+template <typename T>
+void clear_product_component(const SpectralCache& cache_A, const SpectralCache& cache_B,
+                             const ProductComponent& component, DenseMatrix1D<T>& scores)
+{
+    for (const int* i = cache_A.membersBegin(component.component_A); i != cache_A.membersEnd(component.component_A); i++)
+    {
+        for (const int* k = cache_B.membersBegin(component.component_B); k != cache_B.membersEnd(component.component_B); k++)
+        {
+            scores(*i,*k) = 0;
+        }
+    }
+}
+
+#endif
@@ -6,7 +6,6 @@
 #ifndef _UTILITIES_h
 #define _UTILITIES_h
 
-#include "Vertex.h"
 #include "Matrices/DenseMatrix1D.h"
 #include <vector>
 #include <stdio.h>
@@ -174,32 +173,4 @@ DT* scalar_multiplication(DT *old_row,int size, DT scaling_factor){
     return ret_row;
 }
 
-/*
- * takes an array of vertex objects vertices and an integer
- * signifying a component of the graph. The function returns
- * an integer array where vertices that don't belong to the
- * component are masked out.
- * @param: std::vector of pointers to vertex objects
- * @param: the component we wish to mask
- */
-std::vector<int>* component_mask(std::vector<vertex*>& vertices, int component){
-    
-    std::vector<int>* comp_mask = NULL;
-    bool hasConnectedComponeents = false;
-    
-    for(int i=0;i< vertices.size();i++)
-    {
-        vertex* curr_vertex= vertices[i];
-        if(curr_vertex->get_low_link()==component){
-            if (!hasConnectedComponeents)
-            {
-                comp_mask = new std::vector<int>(vertices.size(),0);
-                hasConnectedComponeents = true;
-            }
-            (*comp_mask)[i] = 1;
-        }
-    }
-    return comp_mask;
-}
-
 #endif
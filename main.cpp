@@ -28,12 +28,20 @@
 #include <string.h>
 #include <iostream>
 #include <sstream>
+#include <fstream>
 #include <vector>
 #include <ctime>
+#include <chrono>
 #include "Matrices/SymMatrix.h"
 #include "Matrices/DenseMatrix1D.h"
+#include "Matrices/CSRGraph.h"
+#include "Matrices/GraphPack.h"
 #include "Matrices/MPI_Structs.h"
 #include "IsoRank.h"
+#include "Random.h"
+#include "PairScheduler.h"
+#include "CostModel.h"
+#include "GraphLoader.h"
 
 #ifdef USE_MPI
 #include "mpi.h"
@@ -57,25 +65,45 @@ int G_GRAPH_MATCHING_ALGORITHM = 0;
 bool G_PRINT = false;
 bool G_DEBUG = false;
 
+/*
+ * Number of threads used to read the graphs and, in the sequential build, to compare them (0 uses all the cores).
+ * Seed of the random number generators, every pair of graphs gets its own generator seeded from it.
+ * Restarts of the matching algorithm (maximum, patience and threads, on top of the threads above).
+ */
+int G_NUM_THREADS = 0;
+unsigned long long G_SEED = time(NULL);
+RestartPolicy G_RESTART_POLICY;
 
 /*
- * Preprocessor definitions for the used data type
+ * File where the estimated cost and the runtime of every pair are written (empty: no log).
+ */
+std::string G_COST_LOG = "";
+
+/*
+ * Packed graph collection the graphs are read from instead of the directory (empty: read the directory).
+ * Packed graph collection the graphs of the directory are written to by the sequential build (empty: no conversion).
+ */
+std::string G_GRAPH_PACK = "";
+std::string G_PACK_OUTPUT = "";
+
+
+/*
+ * Type of the adjacency matrices of the graphs (0/1 entries).
+ * Type of the scores matrix (SCORES_FLOAT or SCORES_DOUBLE) and the engine of IsoRank for it and the matching
+ * algorithm, looked up in the table of find_isoRank_engine once the command line is parsed.
  */
-#if INT_MATRIX
-typedef int DataType;
-#elif DOUBLE_MATRIX
-typedef double DataType;
-#elif LONG_DOUBLE
-typedef long double DataType;
-#else
 typedef float DataType;
-#endif
+int G_SCORE_TYPE = SCORES_FLOAT;
+IsoRankEngine G_ISORANK_ENGINE = NULL;
 
 /*
  * Function prototypes
  */
 void parseCommandLineArgs(int argc, char * argv[], int ID);
 double timeElapsed(std::clock_t start, std::clock_t end);
+double wallTimeElapsed(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end);
+void writeCostLog(const std::vector<int>& nodes, const std::vector<int>& edges, const std::vector<double>& estimates,
+                  const std::vector<IsoRank_Result>& pair_results, const std::vector<char>& pair_done);
 
 /*****************************************************************************************
 *                                    Sequential method                                   *
@@ -92,82 +120,192 @@ int main(int argc, char * argv[])
     /*
      *Configure the program to use the command line args
      */
-    srand(time(NULL));
     parseCommandLineArgs(argc, argv, 0);
-    
-    /*
-     * Timing Variables
-     */
-    std::clock_t time_start;
-    std::clock_t time_end;
 	
 	/*
 	 *	Input/Result containers
 	 */
 	int total_comparisons;
     std::vector<IsoRank_Result> isoRank_results;
-    std::vector<DenseMatrix1D<DataType>* >input_graphs;
+    std::vector<CSRGraph* >input_csr_graphs;
+    GraphPack* graph_pack = NULL;
     
+    std::chrono::steady_clock::time_point read_start = std::chrono::steady_clock::now();
+    if (!G_GRAPH_PACK.empty())
+    {
+        /*
+         * Mapping the packed collection, the graphs are views of the mapped file
+         */
+        if(G_PRINT)
+            std::cout << "Reading " << G_NUMBER_OF_FILES << " graphs from the pack: " << G_GRAPH_PACK << std::endl;
+        try
+        {
+            graph_pack = new GraphPack(G_GRAPH_PACK);
+            for (int i = 0; i < graph_pack->getNumberOfGraphs() && i < G_NUMBER_OF_FILES; i++)
+            {
+                input_csr_graphs.push_back(new CSRGraph(graph_pack->getGraph(i)));
+            }
+        }
+        catch (std::exception& e)
+        {
+            std::cerr <<"Exception: " << e.what() << '\n' << std::endl;
+            return 1;
+        }
+    }
+    else
+    {
+        /*
+         * Reading the graphs in parallel and storing them
+         */
+        if(G_PRINT)
+            std::cout << "Reading " << G_NUMBER_OF_FILES << " graphs from: " << G_DIR_PATH << std::endl;
+        std::vector<std::string> read_errors;
+        input_csr_graphs = load_graphs<CSRGraph>(G_DIR_PATH, G_FILE_EXTENSION, G_NUMBER_OF_FILES, G_NUM_THREADS, &read_errors);
+        for (int i = 0; i < read_errors.size(); i++)
+        {
+            std::cerr <<"Exception: " << read_errors[i] << '\n' << std::endl;
+        }
+    }
+    total_comparisons = (0.5*(input_csr_graphs.size()-1)*input_csr_graphs.size());
+    std::chrono::steady_clock::time_point read_end = std::chrono::steady_clock::now();
     if(G_PRINT)
-        std::cout << "Reading " << G_NUMBER_OF_FILES << " graphs from: " << G_DIR_PATH << std::endl;
-    std::ostringstream itos_converter;
-    time_start = std::clock();
-    /*
-     * Reading the graphs and storing them
-     */
-    for(int i = 1; i <= G_NUMBER_OF_FILES; i++)
+        std::cout << input_csr_graphs.size() << " of " << G_NUMBER_OF_FILES << " graphs were successfully read in "
+        << wallTimeElapsed(read_start, read_end) << "(ms)." << std::endl;
+    
+    //converting the graphs to a packed collection, nothing is compared
+    if (!G_PACK_OUTPUT.empty())
     {
         try
         {
-            itos_converter << G_DIR_PATH << i << G_FILE_EXTENSION;
-            input_graphs.push_back(new DenseMatrix1D<DataType>(itos_converter.str()));
-            itos_converter.str(""); //clearing the stream
-            itos_converter.clear();
+            GraphPack::write(G_PACK_OUTPUT, input_csr_graphs);
+            std::cout << input_csr_graphs.size() << " graphs were written to the pack: " << G_PACK_OUTPUT << std::endl;
         }
         catch (std::exception& e)
         {
             std::cerr <<"Exception: " << e.what() << '\n' << std::endl;
-            itos_converter.str("");
-            itos_converter.clear();
         }
+        for (int i = 0; i < input_csr_graphs.size(); i++)
+        {
+            delete input_csr_graphs[i];
+        }
+        delete graph_pack;
+        return 0;
+    }
+    
+    //the eigenpairs of every graph are computed once, the scores of the pairs are assembled from them
+    std::chrono::steady_clock::time_point cache_start = std::chrono::steady_clock::now();
+    std::vector<SpectralCache* > input_caches(input_csr_graphs.size());
+    PairScheduler cache_scheduler(input_csr_graphs.size(), G_NUM_THREADS);
+    auto build_cache = [&](int task, int worker)
+    {
+        input_caches[task] = new SpectralCache(*input_csr_graphs[task]);
+    };
+    cache_scheduler.run(build_cache);
+    if(G_PRINT)
+        std::cout << "Spectral caches of " << input_caches.size() << " graphs were computed in "
+        << wallTimeElapsed(cache_start, std::chrono::steady_clock::now()) << "(ms)." << std::endl;
+    
+    //the mixed precision eigenpairs are checked against the all double ones
+    if(G_PRINT && default_eigen_precision() == EIGEN_PRECISION_MIXED)
+    {
+        long low_applications = 0;
+        long applications = 0;
+        long reference_applications = 0;
+        double eigenvalue_loss = 0;
+        double eigenvector_loss = 0;
+        for (int i = 0; i < input_caches.size(); i++)
+        {
+            SpectralCache reference(*input_csr_graphs[i], EIGEN_PRECISION_DOUBLE);
+            double eigenvalue_deviation, eigenvector_deviation;
+            spectral_cache_deviation(*input_caches[i], reference, &eigenvalue_deviation, &eigenvector_deviation);
+            eigenvalue_loss = std::max(eigenvalue_loss, eigenvalue_deviation);
+            eigenvector_loss = std::max(eigenvector_loss, eigenvector_deviation);
+            low_applications += input_caches[i]->getNumberOfLowPrecisionApplications();
+            applications += input_caches[i]->getNumberOfApplications();
+            reference_applications += reference.getNumberOfApplications();
+        }
+        std::cout << "Mixed precision: " << low_applications << " of " << low_applications + applications
+        << " operator applications ran in float (the double eigensolve used " << reference_applications
+        << "), largest deviation from it: eigenvalue "
+        << eigenvalue_loss << ", eigenvector entry " << eigenvector_loss << "." << std::endl;
+        if (eigenvector_loss >= score_tie_tolerance())
+            std::cout << "The deviation is above the tie tolerance " << score_tie_tolerance()
+            << ", ties of the scores can be broken differently than with -precision double." << std::endl;
     }
-    total_comparisons = (0.5*(input_graphs.size()-1)*input_graphs.size());
-    time_end = std::clock();
+    
+    //every pair of graphs is a task, results are stored by pair index so the order does not depend on the threads
+    std::vector<std::pair<int, int> > pairs;
+    for (int i = 0; i < input_csr_graphs.size(); i++)
+    {
+        for (int j = i +1; j < input_csr_graphs.size(); j++)
+        {
+            pairs.push_back(std::make_pair(i, j));
+        }
+    }
+    std::vector<IsoRank_Result> pair_results(pairs.size());
+    std::vector<std::string> pair_errors(pairs.size());
+    std::vector<char> pair_done(pairs.size(), 0);
+    
+    //the most expensive pairs are started first
+    std::vector<int> nodes, edges;
+    for (int i = 0; i < input_csr_graphs.size(); i++)
+    {
+        nodes.push_back(input_csr_graphs[i]->getNumberOfNodes());
+        edges.push_back(input_csr_graphs[i]->getNumberOfEdges());
+    }
+    std::vector<double> estimates;
+    std::vector<int> pair_order = order_pairs_by_cost(nodes, G_GRAPH_MATCHING_ALGORITHM, G_RESTART_POLICY, &estimates);
+    
+    PairScheduler scheduler(pair_order, G_NUM_THREADS);
     if(G_PRINT)
-        std::cout << input_graphs.size() << " of " << G_NUMBER_OF_FILES << " graphs were successfully read in "
-        << timeElapsed(time_start, time_end) << "(ms)." << std::endl;
+        std::cout << "Comparing " << pairs.size() << " pairs of graphs on " << scheduler.getNumberOfThreads() << " threads." << std::endl;
     
-    time_start = std::clock();
-    for (int i = 0; i < input_graphs.size(); i++)
+    std::chrono::steady_clock::time_point wall_start = std::chrono::steady_clock::now();
+    auto compare_pair = [&](int task, int worker)
     {
-        for (int j = i +1; j < input_graphs.size(); j++)
+        int i = pairs[task].first;
+        int j = pairs[task].second;
+        Random rng(Random::pairSeed(G_SEED, i, j));
+        try
         {
-            try
+            if (G_USE_ISORANK)
             {
-                if (G_USE_ISORANK)
-                {
-                    isoRank_results.push_back(isoRank(*input_graphs[i], *input_graphs[j], G_GRAPH_MATCHING_ALGORITHM));
-                }
-                if (G_USE_GPGM)
-                {
-                    //GPGM(mat1,mat2);
-                }
-                
+                pair_results[task] = G_ISORANK_ENGINE(*input_csr_graphs[i], *input_csr_graphs[j], *input_caches[i], *input_caches[j],
+                                                      rng, G_RESTART_POLICY);
+                pair_done[task] = 1;
             }
-            catch (std::exception& e)
+            if (G_USE_GPGM)
             {
-                std::cerr << " Exception: " << e.what() << std::endl;
+                //GPGM(mat1,mat2);
             }
         }
+        catch (std::exception& e)
+        {
+            pair_errors[task] = e.what();
+        }
+    };
+    scheduler.run(compare_pair);
+    std::chrono::steady_clock::time_point wall_end = std::chrono::steady_clock::now();
+    
+    for (int task = 0; task < pairs.size(); task++)
+    {
+        if (pair_done[task])
+        {
+            isoRank_results.push_back(pair_results[task]);
+        }
+        else if (!pair_errors[task].empty())
+        {
+            std::cerr << " Exception: " << pair_errors[task] << std::endl;
+        }
     }
-    time_end = std::clock();
+    writeCostLog(nodes, edges, estimates, pair_results, pair_done);
     
 	
     //printing the results
     if (G_PRINT)
     {
         std::cout << "Computed IsoRank successfully for " << G_NUMBER_OF_FILES << " graphs in "
-        << timeElapsed(time_start, time_end) << "(ms)." << std::endl;
+        << wallTimeElapsed(wall_start, wall_end) << "(ms)." << std::endl;
         
         std::cout << "Frob_norms: ";
         for (int i=0; i < isoRank_results.size(); i++)
@@ -175,6 +313,16 @@ int main(int argc, char * argv[])
             std::cout<< isoRank_results[i].frob_norm << ", ";
         }
         std::cout<<std::endl;
+        
+        std::cout << "Restarts: ";
+        for (int i=0; i < isoRank_results.size(); i++)
+        {
+            std::cout<< isoRank_results[i].restarts << ", ";
+        }
+        std::cout<<std::endl;
+        
+        std::cout << "Matrix pool: " << MatrixPool::getNumberOfRequests() << " buffers were borrowed, "
+        << MatrixPool::getNumberOfHeapAllocations() << " of them were allocated on the heap." << std::endl;
     }
     
     typename std::vector<IsoRank_Result>::iterator res_it;
@@ -183,11 +331,18 @@ int main(int argc, char * argv[])
         delete [] res_it->assignments;
     }
     
-    typename std::vector<DenseMatrix1D<DataType>* >::iterator graph_it;
-    for ( graph_it = input_graphs.begin() ; graph_it < input_graphs.end(); ++graph_it )
+    std::vector<CSRGraph* >::iterator csr_it;
+    for ( csr_it = input_csr_graphs.begin() ; csr_it < input_csr_graphs.end(); ++csr_it )
+    {
+        delete  *csr_it;
+    }
+    
+    std::vector<SpectralCache* >::iterator cache_it;
+    for ( cache_it = input_caches.begin() ; cache_it < input_caches.end(); ++cache_it )
     {
-        delete  *graph_it;
+        delete  *cache_it;
     }
+    delete graph_pack;
     return 0;
 }
 
@@ -203,7 +358,6 @@ int main(int argc, char * argv[])
  */
 int main(int argc, char * argv[])
 {
-    srand(time(NULL));
 	/*
 	 * MPI Variables
 	 */
@@ -218,6 +372,7 @@ int main(int argc, char * argv[])
     const int TAG_1 = 4;
     const int TAG_2 = 10;
     const int TAG_3 = 15;
+    const int TAG_4 = 20;
     
     /*
      * MPI Initialization calls
@@ -235,6 +390,9 @@ int main(int argc, char * argv[])
      */
     parseCommandLineArgs(argc, argv, ID);
     
+    //every processor uses the seed of the master (the one it prints), the default is the time of each processor
+    MPI_Bcast(&G_SEED, 1, MPI_UNSIGNED_LONG_LONG, MASTER_ID, MPI_COMM_WORLD);
+    
     /*
      * Timing Variables
      */
@@ -250,36 +408,27 @@ int main(int argc, char * argv[])
     //======================================================================*MASTER NODE*==============================================================================
     if (ID == MASTER_ID)
     {
+    	//the pairs are sent to the workers as matrices, the node-pair build only reads graph files
+    	if (!G_GRAPH_PACK.empty())
+    		std::cerr << "The node-pair build does not read graph packs, -graphs is ignored." << std::endl;
     	if(G_PRINT)
     		std::cout << "Reading " << G_NUMBER_OF_FILES << " graphs from: " << G_DIR_PATH << std::endl;
-    	time_start = std::clock();
-    	std::ostringstream itos_converter;
-    	std::vector<SymMatrix<DataType>* >input_graphs;
-        
+    	std::chrono::steady_clock::time_point read_start = std::chrono::steady_clock::now();
+    	
     	/*
-    	 * Reading the graphs and storing them
+    	 * Reading the graphs in parallel and storing them
     	 */
-		for(int i = 1; i <= G_NUMBER_OF_FILES; i++)
+    	std::vector<std::string> read_errors;
+    	std::vector<SymMatrix<DataType>* >input_graphs = load_graphs<SymMatrix<DataType> >(G_DIR_PATH, G_FILE_EXTENSION, G_NUMBER_OF_FILES, G_NUM_THREADS, &read_errors);
+		for (int i = 0; i < read_errors.size(); i++)
 		{
-			try
-			{
-				itos_converter << G_DIR_PATH << i << G_FILE_EXTENSION;
-				input_graphs.push_back(new SymMatrix<DataType>(itos_converter.str()));
-				itos_converter.str(""); //clearing the stream
-				itos_converter.clear();
-			}
-			catch (std::exception& e)
-			{
-				std::cerr <<"Exception: " << e.what() << '\n' << std::endl;
-				itos_converter.str("");
-				itos_converter.clear();
-			}
+			std::cerr <<"Exception: " << read_errors[i] << '\n' << std::endl;
 		}
 		total_comparisons = (0.5*(input_graphs.size()-1)*input_graphs.size());
-		time_end = std::clock();
+		std::chrono::steady_clock::time_point read_end = std::chrono::steady_clock::now();
 		if(G_PRINT)
 			std::cout << input_graphs.size() << " of " << G_NUMBER_OF_FILES << " graphs were successfully read in "
-			<< timeElapsed(time_start, time_end) << "(ms)." << std::endl;
+			<< wallTimeElapsed(read_start, read_end) << "(ms)." << std::endl;
         
         /*
     	 * Sending the graphs to worker nodes.
@@ -287,46 +436,75 @@ int main(int argc, char * argv[])
 		time_start = std::clock();
 		int dest_ID = 1;
 		int recv_counter = 0;
+		int sent_counter = 0;
+		
+		//the pairs are sent in order of decreasing estimated cost, results are kept in pair order
+		std::vector<int> nodes, edges;
 		for (int i = 0; i < input_graphs.size(); i++)
 		{
-			for(int j = i + 1; j <  input_graphs.size(); j++)
+			nodes.push_back(input_graphs[i]->getNumberOfRows());
+			//the edges only feed the cost log, counting them is O(n^2) per graph
+			if (!G_COST_LOG.empty())
 			{
-				// Send a pair of graphs to all the worker nodes
-				if (dest_ID < num_procs)
-				{
-					input_graphs[i]->MPI_Send_Matrix(dest_ID, TAG_1 * dest_ID);
-					input_graphs[j]->MPI_Send_Matrix(dest_ID, TAG_1 * dest_ID + TAG_2);
-					
-					if(G_DEBUG)
-						std::cout <<"Master: sending matrix to ID: " << dest_ID << std::endl;
-                    
-					dest_ID++;
-				}
-				// Send additional pairs upon worker node's request
-				else
-				{
-					int dest;
-					//Recv workers ID
-					MPI_Recv(&dest, 1, MPI_INT, MPI_ANY_SOURCE, TAG_1 + TAG_2, MPI_COMM_WORLD,&stat);
-					if(G_DEBUG)
-						std::cout <<"Master: received request for more graphs from: "<< dest<< std::endl;
-                    
-					//Collect the result from worker
-					isoRank_results.push_back(MPI_Recv_IsoRank_Result(dest, TAG_1 * dest + TAG_3, stat));
-					recv_counter++;
-					if(G_DEBUG)
-						std::cout <<"Master: results were received "<< dest<< std::endl;
-                    
-					//Send more graphs to worker node
-					input_graphs[i]->MPI_Send_Matrix(dest, TAG_1 * dest);
-					input_graphs[j]->MPI_Send_Matrix(dest, TAG_1 * dest + TAG_2);
-					if(G_DEBUG)
-						std::cout <<"Master: sending more graphs to: "<< dest<< std::endl;
-				}
+				edges.push_back(count_nonzeros(*input_graphs[i]));
+			}
+		}
+		std::vector<double> estimates;
+		std::vector<int> pair_order = order_pairs_by_cost(nodes, G_GRAPH_MATCHING_ALGORITHM, G_RESTART_POLICY, &estimates);
+		std::vector<IsoRank_Result> pair_results(total_comparisons);
+		std::vector<char> pair_done(total_comparisons, 0);
+		std::vector<int> worker_pair(num_procs, -1);
+		
+		for (int position = 0; position < pair_order.size(); position++)
+		{
+			int pair = pair_order[position];
+			int i, j;
+			PairChunk::pairFromIndex(pair, input_graphs.size(), &i, &j);
+			
+			// Send a pair of graphs to all the worker nodes
+			if (dest_ID < num_procs)
+			{
+				input_graphs[i]->MPI_Send_Matrix(dest_ID, TAG_1 * dest_ID);
+				input_graphs[j]->MPI_Send_Matrix(dest_ID, TAG_1 * dest_ID + TAG_2);
+				int graph_indices[2] = {i, j};
+				MPI_Send(graph_indices, 2, MPI_INT, dest_ID, TAG_1 * dest_ID + TAG_4, MPI_COMM_WORLD);
+				worker_pair[dest_ID] = pair;
+				sent_counter++;
+				
+				if(G_DEBUG)
+					std::cout <<"Master: sending matrix to ID: " << dest_ID << std::endl;
+                
+				dest_ID++;
+			}
+			// Send additional pairs upon worker node's request
+			else
+			{
+				int dest;
+				//Recv workers ID
+				MPI_Recv(&dest, 1, MPI_INT, MPI_ANY_SOURCE, TAG_1 + TAG_2, MPI_COMM_WORLD,&stat);
+				if(G_DEBUG)
+					std::cout <<"Master: received request for more graphs from: "<< dest<< std::endl;
+                
+				//Collect the result from worker
+				pair_results[worker_pair[dest]] = MPI_Recv_IsoRank_Result(dest, TAG_1 * dest + TAG_3, stat);
+				pair_done[worker_pair[dest]] = 1;
+				recv_counter++;
+				if(G_DEBUG)
+					std::cout <<"Master: results were received "<< dest<< std::endl;
+                
+				//Send more graphs to worker node
+				input_graphs[i]->MPI_Send_Matrix(dest, TAG_1 * dest);
+				input_graphs[j]->MPI_Send_Matrix(dest, TAG_1 * dest + TAG_2);
+				int graph_indices[2] = {i, j};
+				MPI_Send(graph_indices, 2, MPI_INT, dest, TAG_1 * dest + TAG_4, MPI_COMM_WORLD);
+				worker_pair[dest] = pair;
+				sent_counter++;
+				if(G_DEBUG)
+					std::cout <<"Master: sending more graphs to: "<< dest<< std::endl;
 			}
 		}
 		// Recv the remaining result
-		while (recv_counter < total_comparisons)
+		while (recv_counter < sent_counter)
 		{
 			int dest;
 			//Recv workers ID
@@ -335,12 +513,22 @@ int main(int argc, char * argv[])
 				std::cout <<"Master: received request for more graphs from: "<< dest<< std::endl;
             
 			//Collect the result from worker
-			isoRank_results.push_back(MPI_Recv_IsoRank_Result(dest, TAG_1 * dest + TAG_3, stat));
+			pair_results[worker_pair[dest]] = MPI_Recv_IsoRank_Result(dest, TAG_1 * dest + TAG_3, stat);
+			pair_done[worker_pair[dest]] = 1;
 			recv_counter++;
 			if(G_DEBUG)
 				std::cout <<"Master: results were received."<< dest<< std::endl;
 		}
 		
+		for (int pair = 0; pair < total_comparisons; pair++)
+		{
+			if (pair_done[pair])
+			{
+				isoRank_results.push_back(pair_results[pair]);
+			}
+		}
+		writeCostLog(nodes, edges, estimates, pair_results, pair_done);
+		
 		//Terminating the slaves by sending a 0*0 matrix to nodes
  		for(int i=1; i < num_procs; i++)
  		{
@@ -364,6 +552,13 @@ int main(int argc, char * argv[])
 				std::cout<< isoRank_results[i].frob_norm << ", ";
 			}
 			std::cout<<std::endl;
+			
+			std::cout<< " restarts: ";
+			for (int i=0; i < isoRank_results.size(); i++)
+			{
+				std::cout<< isoRank_results[i].restarts << ", ";
+			}
+			std::cout<<std::endl;
 		}
 		
 		typename std::vector<IsoRank_Result>::iterator res_it;
@@ -397,6 +592,11 @@ int main(int argc, char * argv[])
 					std::cout << "Process "<< ID << ": received terminate signal from master"<< std::endl;
 				break;
 			}
+			
+			//the indices of the graphs seed the generator of the pair like in the sequential version
+			int graph_indices[2];
+			MPI_Recv(graph_indices, 2, MPI_INT, MASTER_ID, TAG_1 * ID + TAG_4, MPI_COMM_WORLD, &stat);
+			Random rng(Random::pairSeed(G_SEED, graph_indices[0], graph_indices[1]));
 
 			struct IsoRank_Result result;
 			try
@@ -405,7 +605,11 @@ int main(int argc, char * argv[])
 				{
 					if (G_DEBUG)
 						std::cout << "Process " << ID << ": isoRank: started." << std::endl;
-			  		result = isoRank(mat1, mat2, G_GRAPH_MATCHING_ALGORITHM);
+			  		CSRGraph graph1(mat1);
+			  		CSRGraph graph2(mat2);
+			  		SpectralCache cache1(graph1);
+			  		SpectralCache cache2(graph2);
+			  		result = G_ISORANK_ENGINE(graph1, graph2, cache1, cache2, rng, G_RESTART_POLICY);
 			  		if (G_DEBUG)
 						std::cout << "Process " << ID << ": isoRank: end." << std::endl;
 				}
@@ -453,7 +657,6 @@ int main(int argc, char * argv[])
  */
 int main(int argc, char * argv[])
 {
-    srand(time(NULL));
 	/*
 	 * MPI Variables
 	 */  
@@ -468,6 +671,7 @@ int main(int argc, char * argv[])
     const int TAG_1 = 4;
     const int TAG_2 = 10;
     const int TAG_3 = 15;
+    const int TAG_4 = 20;
 
     /*
      * MPI Initialization calls 
@@ -485,6 +689,9 @@ int main(int argc, char * argv[])
      */
     parseCommandLineArgs(argc, argv, ID);
     
+    //every processor uses the seed of the master (the one it prints), the default is the time of each processor
+    MPI_Bcast(&G_SEED, 1, MPI_UNSIGNED_LONG_LONG, MASTER_ID, MPI_COMM_WORLD);
+    
     /*
      * Timing Variables
      */
@@ -501,40 +708,62 @@ int main(int argc, char * argv[])
 //======================================================================*MASTER NODE*==============================================================================
     if (ID == MASTER_ID)
     {
-    	if(G_PRINT)
-    		std::cout << "Reading " << G_NUMBER_OF_FILES << " graphs from: " << G_DIR_PATH << std::endl;
-    	time_start = std::clock();
-    	std::ostringstream itos_converter;
+    	std::chrono::steady_clock::time_point read_start = std::chrono::steady_clock::now();
     	std::vector<SymMatrix<DataType>* >input_graphs;
-
-    	/*
-    	 * Reading the graphs and storing them
-    	 */
-		for(int i = 1; i <= G_NUMBER_OF_FILES; i++)
-		{
-			try
-			{
-				itos_converter << G_DIR_PATH << i << G_FILE_EXTENSION;
-				input_graphs.push_back(new SymMatrix<DataType>(itos_converter.str()));
-				itos_converter.str(""); //clearing the stream
-				itos_converter.clear();
-			}
-			catch (std::exception& e)
-			{
-				std::cerr <<"Exception: " << e.what() << '\n' << std::endl;
-				itos_converter.str("");
-				itos_converter.clear();
-			}
-		}
-		number_of_graphs = input_graphs.size();
+    	std::vector<int> nodes, edges;
+    	if (!G_GRAPH_PACK.empty())
+    	{
+    		/*
+    		 * Every processor maps the packed collection itself, only the number of graphs is sent
+    		 */
+    		if(G_PRINT)
+    			std::cout << "Reading " << G_NUMBER_OF_FILES << " graphs from the pack: " << G_GRAPH_PACK << std::endl;
+    		try
+    		{
+    			GraphPack graph_pack(G_GRAPH_PACK);
+    			for (int i = 0; i < graph_pack.getNumberOfGraphs() && i < G_NUMBER_OF_FILES; i++)
+    			{
+    				nodes.push_back(graph_pack.getNumberOfNodes(i));
+    				edges.push_back(graph_pack.getNumberOfEdges(i));
+    			}
+    		}
+    		catch (std::exception& e)
+    		{
+    			std::cerr <<"Exception: " << e.what() << '\n' << std::endl;
+    		}
+    	}
+    	else
+    	{
+    		/*
+    		 * Reading the graphs in parallel and storing them
+    		 */
+    		if(G_PRINT)
+    			std::cout << "Reading " << G_NUMBER_OF_FILES << " graphs from: " << G_DIR_PATH << std::endl;
+    		std::vector<std::string> read_errors;
+    		input_graphs = load_graphs<SymMatrix<DataType> >(G_DIR_PATH, G_FILE_EXTENSION, G_NUMBER_OF_FILES, G_NUM_THREADS, &read_errors);
+    		for (int i = 0; i < read_errors.size(); i++)
+    		{
+    			std::cerr <<"Exception: " << read_errors[i] << '\n' << std::endl;
+    		}
+    		for (int i = 0; i < input_graphs.size(); i++)
+    		{
+    			nodes.push_back(input_graphs[i]->getNumberOfRows());
+    			//the edges only feed the cost log, counting them is O(n^2) per graph
+    			if (!G_COST_LOG.empty())
+    			{
+    				edges.push_back(count_nonzeros(*input_graphs[i]));
+    			}
+    		}
+    	}
+		number_of_graphs = nodes.size();
 		total_comparisons = (0.5*(number_of_graphs-1)*number_of_graphs);
-		time_end = std::clock();
+		std::chrono::steady_clock::time_point read_end = std::chrono::steady_clock::now();
 		if(G_PRINT)
-			std::cout << input_graphs.size() << " of " << G_NUMBER_OF_FILES << " graphs were successfully read in "
-			<< timeElapsed(time_start, time_end) << "(ms)." << std::endl;
+			std::cout << number_of_graphs << " of " << G_NUMBER_OF_FILES << " graphs were successfully read in "
+			<< wallTimeElapsed(read_start, read_end) << "(ms)." << std::endl;
 
 		/*
-    	 * Sending the graphs to worker nodes.
+    	 * Sending the graphs to worker nodes (none are sent when the workers map the pack).
     	 */
 		time_start = std::clock();
 		MPI_Bcast (&number_of_graphs, 1 , MPI_INT, MASTER_ID, MPI_COMM_WORLD);
@@ -546,23 +775,57 @@ int main(int argc, char * argv[])
 		}
 		
 		/*
-		 * Collecting the results from the worker nodes.
+		 * Handing out chunks of pairs and collecting the results from the worker nodes.
+		 * Chunks are taken from the pairs sorted by decreasing estimated cost, the workers compute the same order.
+		 * A worker sends {ID, pair}: pair == -1 asks for a new chunk, otherwise the result of the pair follows.
 		 */
-		int recv_counter = 0;
-		while (recv_counter < total_comparisons)
+		std::vector<double> estimates;
+		order_pairs_by_cost(nodes, G_GRAPH_MATCHING_ALGORITHM, G_RESTART_POLICY, &estimates);
+		std::vector<IsoRank_Result> pair_results(total_comparisons);
+		std::vector<char> pair_done(total_comparisons, 0);
+		int next_position = 0;
+		int active_workers = num_procs - 1;
+		while (active_workers > 0)
 		{
-			int dest;
-			//Recv workers ID
-			MPI_Recv(&dest, 1, MPI_INT, MPI_ANY_SOURCE, TAG_1 + TAG_2, MPI_COMM_WORLD,&stat);
-			if(G_DEBUG)
-				std::cout <<"Master: received signal to receive result from: "<< dest<< std::endl;
-
-			//Collect the result from worker
-			isoRank_results.push_back(MPI_Recv_IsoRank_Result(dest, TAG_1 * dest + TAG_3, stat));
-			recv_counter++;
-			if(G_DEBUG)
-				std::cout <<"Master: results were received."<< dest<< std::endl;
+			int request[2];
+			MPI_Recv(request, 2, MPI_INT, MPI_ANY_SOURCE, TAG_1 + TAG_2, MPI_COMM_WORLD,&stat);
+			int dest = request[0];
+			int pair = request[1];
+			
+			if (pair >= 0)
+			{
+				if(G_DEBUG)
+					std::cout <<"Master: received signal to receive result of pair " << pair << " from: "<< dest<< std::endl;
+				
+				//Collect the result from worker
+				pair_results[pair] = MPI_Recv_IsoRank_Result(dest, TAG_1 * dest + TAG_3, stat);
+				pair_done[pair] = 1;
+			}
+			else
+			{
+				//Send the next chunk of pairs, an empty chunk terminates the worker
+				PairChunk chunk;
+				chunk.setValues(next_position, total_comparisons, num_procs - 1);
+				next_position += chunk.count;
+				MPI_Send(&chunk, 2, MPI_INT, dest, TAG_1 * dest + TAG_4, MPI_COMM_WORLD);
+				if (chunk.count == 0)
+				{
+					active_workers--;
+				}
+				if(G_DEBUG)
+					std::cout <<"Master: sent positions " << chunk.start << " to " << chunk.start + chunk.count - 1 << " to: "<< dest<< std::endl;
+			}
+		}
+		
+		//results are kept in pair order
+		for (int pair = 0; pair < total_comparisons; pair++)
+		{
+			if (pair_done[pair])
+			{
+				isoRank_results.push_back(pair_results[pair]);
+			}
 		}
+		writeCostLog(nodes, edges, estimates, pair_results, pair_done);
 		
  		time_end = std::clock();
 
@@ -578,6 +841,13 @@ int main(int argc, char * argv[])
 				std::cout<< isoRank_results[i].frob_norm << ", ";
 			}
 			std::cout<<std::endl;
+			
+			std::cout<< " restarts: ";
+			for (int i=0; i < isoRank_results.size(); i++)
+			{
+				std::cout<< isoRank_results[i].restarts << ", ";
+			}
+			std::cout<<std::endl;
 		}
 		
 		typename std::vector<IsoRank_Result>::iterator res_it;
@@ -596,42 +866,75 @@ int main(int argc, char * argv[])
     else
     {
     	
-    	std::vector<DenseMatrix1D<DataType>* > recv_graphs;
+    	std::vector<CSRGraph* > recv_csr_graphs;
+    	GraphPack* graph_pack = NULL;
     	
     	MPI_Bcast (&number_of_graphs, 1, MPI_INT, MASTER_ID, MPI_COMM_WORLD);
-    	for (int i = 0; i < number_of_graphs; i++)
+    	if (!G_GRAPH_PACK.empty() && number_of_graphs > 0)
     	{
-    		recv_graphs.push_back(new DenseMatrix1D<DataType>(MASTER_ID, stat));
+    		//the pack must be visible to every processor (shared storage), the graphs are views of the mapped file
+    		try
+    		{
+    			graph_pack = new GraphPack(G_GRAPH_PACK);
+    			for (int i = 0; i < number_of_graphs; i++)
+    			{
+    				recv_csr_graphs.push_back(new CSRGraph(graph_pack->getGraph(i)));
+    			}
+    		}
+    		catch (std::exception& e)
+    		{
+    			std::cerr << "Process "<< ID << " Exception: " << e.what() << std::endl;
+    			MPI_Abort(MPI_COMM_WORLD, 1);
+    		}
+    	}
+    	else
+    	{
+    		for (int i = 0; i < number_of_graphs; i++)
+    		{
+    			DenseMatrix1D<DataType> recv_graph(MASTER_ID, stat);
+    			recv_csr_graphs.push_back(new CSRGraph(recv_graph));
+    		}
     	}
 
 		if (G_DEBUG)
 			std::cout << "Process "<< ID << " : received " << number_of_graphs << " graphs from master"<< std::endl;
+		
+		//the eigenpairs of every graph are computed once, the scores of the pairs are assembled from them
+		std::vector<SpectralCache* > recv_caches;
+		for (int i = 0; i < number_of_graphs; i++)
+		{
+			recv_caches.push_back(new SpectralCache(*recv_csr_graphs[i]));
+		}
+		
+		//the chunks are positions in the pairs sorted by decreasing estimated cost
+		std::vector<int> nodes, edges;
+		for (int i = 0; i < number_of_graphs; i++)
+		{
+			nodes.push_back(recv_csr_graphs[i]->getNumberOfNodes());
+			edges.push_back(recv_csr_graphs[i]->getNumberOfEdges());
+		}
+		std::vector<double> estimates;
+		std::vector<int> pair_order = order_pairs_by_cost(nodes, G_GRAPH_MATCHING_ALGORITHM, G_RESTART_POLICY, &estimates);
 	
-        Offset offset;
-        offset.setValues(ID, num_procs, number_of_graphs);
-        int A, B;
-		for (int i = offset.i_start; i <= offset.i_end; i++)
-		{	
-            if (i == offset.i_start)
-            {
-                A = offset.j_start;
-            }
-            else
-            {
-                A = i+1;
-            }
-
-            if (i == offset.i_end)
-            {
-                B = offset.j_end;
-            }
-            else 
-            {
-                B = number_of_graphs - 1;
-            }
-
-			for (int j = A; j <= B; j++)
+		while (true)
+		{
+			//Ask the master for a chunk of pairs
+			int request[2] = {ID, -1};
+			PairChunk chunk;
+			MPI_Send(request, 2, MPI_INT, MASTER_ID, TAG_1 + TAG_2, MPI_COMM_WORLD);
+			MPI_Recv(&chunk, 2, MPI_INT, MASTER_ID, TAG_1 * ID + TAG_4, MPI_COMM_WORLD, &stat);
+			if (chunk.count == 0)
+			{
+				if (G_DEBUG)
+					std::cout << "Process "<< ID << ": received terminate signal from master"<< std::endl;
+				break;
+			}
+			
+			for (int position = chunk.start; position < chunk.start + chunk.count; position++)
 			{	
+				int pair = pair_order[position];
+				int i, j;
+				PairChunk::pairFromIndex(pair, number_of_graphs, &i, &j);
 				struct IsoRank_Result result;
 				try
 				{
@@ -639,7 +942,9 @@ int main(int argc, char * argv[])
 					{	
 						if (G_DEBUG)
 							std::cout << "Process " << ID << ": isoRank: started."  << i << " " << j << std::endl;
-						result = isoRank(*recv_graphs[i], *recv_graphs[j], G_GRAPH_MATCHING_ALGORITHM);
+						Random rng(Random::pairSeed(G_SEED, i, j));
+						result = G_ISORANK_ENGINE(*recv_csr_graphs[i], *recv_csr_graphs[j], *recv_caches[i], *recv_caches[j],
+						                          rng, G_RESTART_POLICY);
 						if (G_DEBUG)
 							std::cout << "Process " << ID << ": isoRank: end." << std::endl;
 					}
@@ -648,8 +953,9 @@ int main(int argc, char * argv[])
 						//GPGM(mat1,mat2);
 					}
 						
-					//Sending the ID to master for more graphs
-					MPI_Send(&ID, 1, MPI_INT, MASTER_ID, TAG_1 + TAG_2, MPI_COMM_WORLD);
+					//Telling the master which pair the result belongs to
+					request[1] = pair;
+					MPI_Send(request, 2, MPI_INT, MASTER_ID, TAG_1 + TAG_2, MPI_COMM_WORLD);
 
 					if (G_DEBUG)
 					  std::cout << "Process "<< ID << " :sending result to master" << std::endl;
@@ -664,11 +970,18 @@ int main(int argc, char * argv[])
 				}
 			}
 		}
-		typename std::vector<DenseMatrix1D<DataType>* >::iterator graph_it;
-		for ( graph_it = recv_graphs.begin() ; graph_it < recv_graphs.end(); ++graph_it )
+		std::vector<CSRGraph* >::iterator csr_it;
+		for ( csr_it = recv_csr_graphs.begin() ; csr_it < recv_csr_graphs.end(); ++csr_it )
 		{
-			delete  *graph_it;
+			delete  *csr_it;
 		}
+		
+		std::vector<SpectralCache* >::iterator cache_it;
+		for ( cache_it = recv_caches.begin() ; cache_it < recv_caches.end(); ++cache_it )
+		{
+			delete  *cache_it;
+		}
+		delete graph_pack;
 	}			
 		
 	
@@ -690,6 +1003,54 @@ double timeElapsed(std::clock_t start, std::clock_t end)
     return (double) (end - start) / CLOCKS_PER_SEC * 1000.0;
 }
 
+/*
+ * Calculates the wall clock time elapsed (std::clock adds up the time of all the threads)
+ * @pram std::chrono::steady_clock::time_point  start_time
+ * @pram std::chrono::steady_clock::time_point  end_time
+ */
+double wallTimeElapsed(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+{
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+/*
+ * Writes the estimated cost and the runtime of every pair to G_COST_LOG (if set), one pair per line:
+ * graph_i graph_j nodes_i nodes_j edges_i edges_j estimate runtime(ms) restarts
+ * @pram std::vector<int>: number of nodes of every graph
+ * @pram std::vector<int>: number of non-zero entries of every graph
+ * @pram std::vector<double>: estimated cost of every pair (by pair number)
+ * @pram std::vector<IsoRank_Result>: result of every pair (by pair number)
+ * @pram std::vector<char>: 1 for the pairs that have a result
+ */
+void writeCostLog(const std::vector<int>& nodes, const std::vector<int>& edges, const std::vector<double>& estimates,
+                  const std::vector<IsoRank_Result>& pair_results, const std::vector<char>& pair_done)
+{
+    if (G_COST_LOG.empty())
+    {
+        return;
+    }
+    std::ofstream log_writer(G_COST_LOG.c_str());
+    if (!log_writer.is_open())
+    {
+        std::cerr << "Could not open the cost log '" << G_COST_LOG << "'." << std::endl;
+        return;
+    }
+    
+    log_writer << "# graph_i graph_j nodes_i nodes_j edges_i edges_j estimate runtime_ms restarts" << '\n';
+    int pair = 0;
+    for (int i = 0; i < nodes.size(); i++)
+    {
+        for (int j = i + 1; j < nodes.size(); j++, pair++)
+        {
+            if (pair_done[pair])
+            {
+                log_writer << i + 1 << ' ' << j + 1 << ' ' << nodes[i] << ' ' << nodes[j] << ' ' << edges[i] << ' ' << edges[j]
+                           << ' ' << estimates[pair] << ' ' << pair_results[pair].runtime << ' ' << pair_results[pair].restarts << '\n';
+            }
+        }
+    }
+}
+
 /*
  * This method Configures the setting of the program according to the command line agrs.
  * @pram int argc
@@ -817,6 +1178,164 @@ void parseCommandLineArgs(int argc,char* argv[], int ID)
                         std::cout << "Algorithm '" << argv [i] <<  "' is not a valid algorithm." << std::endl;
                 }
             }
+            //changing the number of threads of the sequential build
+            else if (std::strncmp(argv[i], "-threads", 8) == 0)
+            {
+                i++;
+                int input_number = atoi(argv[i]);
+                if ( input_number > 0)
+                {
+                    G_NUM_THREADS = input_number;
+                    if (ID == 0)
+                        std::cout << "Number of threads was set to: " << G_NUM_THREADS << std::endl;
+                }
+                // the input is not a number or it's an invalid number
+                else
+                {
+                    if (ID == 0)
+                        std::cout << "'" << argv[i] << "' is not a valid number." << std::endl;
+                }
+            }
+            //changing the maximum number of restarts of the matching algorithm
+            else if (std::strncmp(argv[i], "-restarts", 9) == 0)
+            {
+                i++;
+                int input_number = atoi(argv[i]);
+                if ( input_number > 0)
+                {
+                    G_RESTART_POLICY.max_restarts = input_number;
+                    if (ID == 0)
+                        std::cout << "Maximum number of restarts was set to: " << G_RESTART_POLICY.max_restarts << std::endl;
+                }
+                // the input is not a number or it's an invalid number
+                else
+                {
+                    if (ID == 0)
+                        std::cout << "'" << argv[i] << "' is not a valid number." << std::endl;
+                }
+            }
+            //stopping the restarts after a number of restarts without a better assignment
+            else if (std::strncmp(argv[i], "-restart_patience", 17) == 0)
+            {
+                i++;
+                int input_number = atoi(argv[i]);
+                if ( input_number > 0)
+                {
+                    G_RESTART_POLICY.patience = input_number;
+                    if (ID == 0)
+                        std::cout << "Restart patience was set to: " << G_RESTART_POLICY.patience << std::endl;
+                }
+                // the input is not a number or it's an invalid number
+                else
+                {
+                    if (ID == 0)
+                        std::cout << "'" << argv[i] << "' is not a valid number." << std::endl;
+                }
+            }
+            //changing the number of threads running the restarts of the matching algorithm
+            else if (std::strncmp(argv[i], "-restart_threads", 16) == 0)
+            {
+                i++;
+                int input_number = atoi(argv[i]);
+                if ( input_number > 0)
+                {
+                    G_RESTART_POLICY.threads = input_number;
+                    if (ID == 0)
+                        std::cout << "Number of restart threads was set to: " << G_RESTART_POLICY.threads << std::endl;
+                }
+                // the input is not a number or it's an invalid number
+                else
+                {
+                    if (ID == 0)
+                        std::cout << "'" << argv[i] << "' is not a valid number." << std::endl;
+                }
+            }
+            //changing the seed of the random number generators
+            else if (std::strncmp(argv[i], "-seed", 5) == 0)
+            {
+                i++;
+                G_SEED = strtoull(argv[i], NULL, 10);
+                if (ID == 0)
+                    std::cout << "Seed was set to: " << G_SEED << std::endl;
+            }
+            //changing the type of the scores matrix
+            else if (std::strncmp(argv[i], "-scores", 7) == 0)
+            {
+                i++;
+                if (std::strncmp(argv[i], "float", 5) == 0)
+                {
+                    G_SCORE_TYPE = SCORES_FLOAT;
+                }
+                else if (std::strncmp(argv[i], "double", 6) == 0)
+                {
+                    G_SCORE_TYPE = SCORES_DOUBLE;
+                }
+                else
+                {
+                    if (ID == 0)
+                        std::cout << "Score type '" << argv [i] <<  "' is not a valid type." << std::endl;
+                }
+            }
+            //changing the precision of the eigensolves
+            else if (std::strncmp(argv[i], "-precision", 10) == 0)
+            {
+                i++;
+                if (std::strncmp(argv[i], "double", 6) == 0)
+                {
+                    default_eigen_precision() = EIGEN_PRECISION_DOUBLE;
+                }
+                else if (std::strncmp(argv[i], "mixed", 5) == 0)
+                {
+                    default_eigen_precision() = EIGEN_PRECISION_MIXED;
+                }
+                else
+                {
+                    if (ID == 0)
+                        std::cout << "Precision '" << argv [i] <<  "' is not a valid precision." << std::endl;
+                }
+            }
+            //changing the tolerance under which two scores are a tie for the matching algorithms
+            else if (std::strncmp(argv[i], "-tie_tolerance", 14) == 0)
+            {
+                i++;
+                float input_number = atof(argv[i]);
+                if ( input_number > 0)
+                {
+                    score_tie_tolerance() = input_number;
+                    if (ID == 0)
+                        std::cout << "Tie tolerance was set to: " << score_tie_tolerance() << std::endl;
+                }
+                // the input is not a number or it's an invalid number
+                else
+                {
+                    if (ID == 0)
+                        std::cout << "'" << argv[i] << "' is not a valid number." << std::endl;
+                }
+            }
+            //writing the estimated cost and the runtime of every pair to a file
+            else if (std::strncmp(argv[i], "-cost_log", 9) == 0)
+            {
+                i++;
+                G_COST_LOG = std::string(argv[i]);
+                if (ID == 0)
+                    std::cout << "Cost log was set to: " << G_COST_LOG << std::endl;
+            }
+            //reading the graphs from a packed collection
+            else if (std::strncmp(argv[i], "-graphs", 7) == 0)
+            {
+                i++;
+                G_GRAPH_PACK = std::string(argv[i]);
+                if (ID == 0)
+                    std::cout << "Graph pack was set to: " << G_GRAPH_PACK << std::endl;
+            }
+            //converting the graph files to a packed collection
+            else if (std::strncmp(argv[i], "-pack", 5) == 0)
+            {
+                i++;
+                G_PACK_OUTPUT = std::string(argv[i]);
+                if (ID == 0)
+                    std::cout << "Graphs will be packed to: " << G_PACK_OUTPUT << std::endl;
+            }
             //Print to console
             else if (std::strncmp(argv[i], "-print", 6) == 0)
             {
@@ -838,12 +1357,31 @@ void parseCommandLineArgs(int argc,char* argv[], int ID)
                     std::cout << "Arg '" << argv [i] <<  "' is not a valid argument." << std::endl;
             }
         }
+        G_ISORANK_ENGINE = find_isoRank_engine(G_SCORE_TYPE, G_GRAPH_MATCHING_ALGORITHM);
         if (ID == 0)
         {
             std::cout << "\n\n" <<"Program configuration: " << std::endl;
-            std::cout << "Working directory: '" << G_DIR_PATH << "'" << std::endl;
-            std::cout << "File Extension: '" << G_FILE_EXTENSION << "'" << std::endl;
+            if (G_GRAPH_PACK.empty())
+            {
+                std::cout << "Working directory: '" << G_DIR_PATH << "'" << std::endl;
+                std::cout << "File Extension: '" << G_FILE_EXTENSION << "'" << std::endl;
+            }
+            else
+            {
+                std::cout << "Graph pack: '" << G_GRAPH_PACK << "'" << std::endl;
+            }
             std::cout << "Number of graphs to read: " << G_NUMBER_OF_FILES << std::endl;
+            std::cout << "Seed: " << G_SEED << std::endl;
+            std::cout << "Maximum number of restarts: " << G_RESTART_POLICY.max_restarts;
+            if (G_RESTART_POLICY.patience > 0)
+                std::cout << " (patience: " << G_RESTART_POLICY.patience << ")";
+            std::cout << std::endl;
+            std::cout << "Score type: " << ((G_SCORE_TYPE == SCORES_DOUBLE) ? "double." : "float.") << std::endl;
+            if (default_eigen_precision() == EIGEN_PRECISION_MIXED)
+                std::cout << "Eigensolve precision: mixed (float iterations, double refinement)." << std::endl;
+            else
+                std::cout << "Eigensolve precision: double." << std::endl;
+            std::cout << "Score tie tolerance: " << score_tie_tolerance() << std::endl;
             if (G_USE_ISORANK)
             {
                 std::cout << "Graph matching algorithm: IsoRank." << std::endl;